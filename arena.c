@@ -0,0 +1,31 @@
+#include "arena.h"
+#include <furi.h>
+#include <stdlib.h>
+#include <string.h>
+
+bool arena_init(Arena* arena, size_t capacity) {
+    memset(arena, 0, sizeof(Arena));
+    arena->base = malloc(capacity);
+    if(arena->base == NULL) return false;
+    arena->capacity = capacity;
+    return true;
+}
+
+void arena_free(Arena* arena) {
+    free(arena->base);
+    memset(arena, 0, sizeof(Arena));
+}
+
+void* arena_alloc(Arena* arena, size_t size) {
+    size_t start = (arena->used + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+    if(start > arena->capacity || size > arena->capacity - start) {
+        arena->failed++;
+        FURI_LOG_W("Arena", "Out of space for %u bytes (%u of %u used)",
+                   (unsigned)size, (unsigned)arena->used, (unsigned)arena->capacity);
+        return NULL;
+    }
+
+    arena->used = start + size;
+    if(arena->used > arena->peak) arena->peak = arena->used;
+    return arena->base + start;
+}
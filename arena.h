@@ -0,0 +1,42 @@
+// arena.h - Bump allocator for scene lifetime buffers
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#define ARENA_ALIGN 8
+
+// One block taken from the heap at launch. Allocation only moves a cursor,
+// buffers are never freed one by one: everything above a mark is released
+// at once when its owner (a map, a scene) goes away.
+typedef struct {
+    uint8_t* base;
+    size_t capacity;
+    size_t used;
+    size_t peak;     // Highest used since arena_init
+    uint32_t failed; // Allocations that did not fit
+} Arena;
+
+// Allocate the backing block, false if the heap cannot spare it
+bool arena_init(Arena* arena, size_t capacity);
+void arena_free(Arena* arena);
+
+// Aligned block of size bytes, NULL if the arena is full. Memory is not cleared.
+void* arena_alloc(Arena* arena, size_t size);
+
+// Current cursor, pass it to arena_release to drop everything allocated after it
+static inline size_t arena_mark(const Arena* arena) {
+    return arena->used;
+}
+
+static inline void arena_release(Arena* arena, size_t mark) {
+    if(mark < arena->used) arena->used = mark;
+}
+
+static inline void arena_reset(Arena* arena) {
+    arena->used = 0;
+}
+
+#endif // ARENA_H
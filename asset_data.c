@@ -0,0 +1,88 @@
+// asset_data.c - Generated by tools/gen_assets.py, do not edit
+// 13 sprites, 84 cells (57 unique), 1080 bytes packed vs 1272 unpacked
+#include "asset_data.h"
+
+static const uint8_t asset_cells[57 * MASKED_SPRITE_CELL_BYTES] = {
+    0x00, 0x00, 0xc0, 0xc0, 0x30, 0xf0, 0x7c, 0xfc, 0xe2, 0xfe, 0xc1, 0xff, 0xc1, 0xff, 0xc1, 0xff,
+    0x00, 0x00, 0x0c, 0x0c, 0x13, 0x1f, 0x7f, 0x7f, 0x9e, 0xff, 0xb2, 0xff, 0xe5, 0xff, 0x25, 0x3f,
+    0x00, 0x00, 0x80, 0x80, 0x60, 0xe0, 0xf8, 0xf8, 0xc4, 0xfc, 0x82, 0xfe, 0x82, 0xfe, 0x82, 0xfe,
+    0x00, 0x00, 0x07, 0x07, 0x0a, 0x0f, 0x1e, 0x1f, 0x7d, 0x7f, 0xa5, 0xff, 0xcb, 0xff, 0xcb, 0xff,
+    0x4b, 0x7f, 0x4b, 0x7f, 0x25, 0x3f, 0x3d, 0x3f, 0x26, 0x3f, 0x26, 0x3f, 0x19, 0x19, 0x00, 0x00,
+    0x00, 0x00, 0x03, 0x03, 0x05, 0x07, 0x0f, 0x0f, 0x3e, 0x3f, 0x52, 0x7f, 0x65, 0x7f, 0x65, 0x7f,
+    0x25, 0x3f, 0x25, 0x3f, 0x12, 0x1f, 0x1e, 0x1f, 0x13, 0x1f, 0x13, 0x1f, 0x0c, 0x0c, 0x00, 0x00,
+    0x00, 0x00, 0xc0, 0xc0, 0x30, 0xf0, 0x7c, 0xfc, 0x12, 0xfe, 0x29, 0xff, 0xa9, 0xff, 0x29, 0xff,
+    0x29, 0xff, 0xa9, 0xff, 0x29, 0xff, 0x32, 0xfe, 0x7c, 0xfc, 0x30, 0xf0, 0xc0, 0xc0, 0x00, 0x00,
+    0x00, 0x00, 0x18, 0x18, 0x25, 0x3d, 0x67, 0x7f, 0xbe, 0xff, 0xa4, 0xff, 0xe5, 0xff, 0x6c, 0x7f,
+    0x00, 0x00, 0x80, 0x80, 0x60, 0xe0, 0xf8, 0xf8, 0x64, 0xfc, 0x52, 0xfe, 0x52, 0xfe, 0x52, 0xfe,
+    0x52, 0xfe, 0x52, 0xfe, 0x52, 0xfe, 0x24, 0xfc, 0xf8, 0xf8, 0x60, 0xe0, 0x80, 0x80, 0x00, 0x00,
+    0x00, 0x00, 0x07, 0x07, 0x1a, 0x1f, 0x6e, 0x7f, 0xbc, 0xff, 0xa8, 0xff, 0xcb, 0xff, 0x58, 0x7f,
+    0x58, 0x7f, 0x7b, 0x7f, 0x48, 0x7f, 0x4c, 0x7f, 0x3e, 0x3f, 0x06, 0x07, 0x01, 0x01, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x10, 0xec, 0xfc, 0x2a, 0xfe, 0xe9, 0xff, 0x29, 0xff,
+    0x31, 0xff, 0xe1, 0xff, 0x61, 0xff, 0x61, 0xff, 0xe2, 0xfe, 0xfc, 0xfc, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x42, 0x43, 0xec, 0xef, 0xfc, 0xff,
+    0xcc, 0xff, 0xcc, 0xff, 0xbe, 0xff, 0x62, 0x7f, 0x23, 0x3f, 0x1d, 0x1d, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x11, 0x2a, 0x3b, 0xcc, 0xff, 0xd4, 0xff,
+    0xa4, 0xbf, 0xbc, 0xbf, 0xa6, 0xbf, 0x26, 0x3f, 0x5b, 0x7f, 0x4d, 0x7d, 0x30, 0x30, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xfc, 0xfc, 0xe2, 0xfe, 0x61, 0xff, 0x61, 0xff,
+    0xe1, 0xff, 0x31, 0xff, 0x29, 0xff, 0xe9, 0xff, 0x2a, 0xfe, 0xec, 0xfc, 0x10, 0x10, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1d, 0x1d, 0x23, 0x3f, 0x62, 0x7f, 0xbe, 0xff,
+    0xcc, 0xff, 0xcc, 0xff, 0xfc, 0xff, 0xec, 0xef, 0x42, 0x43, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xf8, 0xf8, 0xc4, 0xfc, 0xc2, 0xfe, 0xc2, 0xfe,
+    0xc2, 0xfe, 0x62, 0xfe, 0x52, 0xfe, 0xd2, 0xfe, 0x54, 0xfc, 0xd8, 0xf8, 0x20, 0x20, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x60, 0x9b, 0xfb, 0xb7, 0xff, 0x4c, 0x7f, 0x4c, 0x7f,
+    0x79, 0x7f, 0x48, 0x7f, 0xa8, 0xff, 0x99, 0xff, 0x54, 0x77, 0x23, 0x23, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x20, 0x20, 0x20,
+    0x20, 0x20, 0x20, 0x20, 0x10, 0x10, 0x10, 0x10, 0x08, 0x08, 0x70, 0x70, 0x90, 0xf0, 0xe0, 0xe0,
+    0x00, 0x00, 0x00, 0x00, 0x80, 0x80, 0xfe, 0xfe, 0x11, 0xff, 0x09, 0xff, 0x02, 0xfe, 0x06, 0xfe,
+    0x04, 0xfc, 0x62, 0xfe, 0x72, 0xfe, 0x7a, 0xfe, 0x3a, 0xfe, 0x1a, 0xfe, 0x02, 0xfe, 0x02, 0xfe,
+    0x82, 0xfe, 0x46, 0xfe, 0x42, 0xfe, 0x82, 0xfe, 0x01, 0xff, 0x81, 0xff, 0xfe, 0xfe, 0xf0, 0xf0,
+    0x80, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0x07, 0x19, 0x1f,
+    0xe2, 0xfe, 0x0c, 0xfc, 0x30, 0xf0, 0xc0, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x7c, 0x7c, 0xe3, 0xff, 0xdf, 0xff, 0x53, 0xff, 0x9c, 0xff, 0x80, 0xff, 0x40, 0xff,
+    0x00, 0xff, 0x06, 0xff, 0x47, 0xff, 0x03, 0xff, 0x80, 0xff, 0x80, 0xff, 0x9c, 0xff, 0x9f, 0xff,
+    0x93, 0xff, 0x47, 0xff, 0xc4, 0xff, 0xe0, 0xff, 0xf3, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xfc, 0xfc, 0xf8, 0xf8, 0xf0, 0xf0, 0xf0, 0xf0, 0xe8, 0xf8, 0xc6, 0xfe,
+    0xc1, 0xff, 0x20, 0x3f, 0x18, 0x1f, 0x07, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x03, 0x03, 0x03, 0x03, 0x1f, 0x1f, 0xef, 0xff,
+    0x6f, 0xff, 0x0f, 0xff, 0x1f, 0xff, 0x7d, 0xff, 0xfd, 0xff, 0xfd, 0xff, 0xfd, 0xff, 0x7f, 0x7f,
+    0x7f, 0x7f, 0xff, 0xff, 0x7f, 0xff, 0xef, 0xff, 0xcf, 0xff, 0x1f, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0x7f, 0x7f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0x3c, 0x3c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x02,
+    0x05, 0x07, 0x06, 0x07, 0x05, 0x07, 0x06, 0x07, 0x07, 0x07, 0x03, 0x03, 0x01, 0x01, 0x00, 0x00,
+    0x04, 0x04, 0x0b, 0x0f, 0x0c, 0x0f, 0x0a, 0x0f, 0x0c, 0x0f, 0x0a, 0x0f, 0x07, 0x07, 0x03, 0x03,
+    0x00, 0x00, 0x00, 0x00, 0x01, 0x01, 0x02, 0x03, 0x03, 0x03, 0x02, 0x03, 0x03, 0x03, 0x02, 0x03,
+    0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x3c, 0x3c, 0x62, 0x7e, 0x44, 0x7c, 0x58, 0x78, 0x64, 0x7c, 0x32, 0x3e, 0x0e, 0x0e, 0x00, 0x00,
+    0x00, 0x00, 0x3c, 0x3c, 0x62, 0x7e, 0x44, 0x7c, 0x58, 0x78, 0x64, 0x7c, 0x32, 0x3e, 0x0e, 0x0e,
+    0x78, 0x78, 0xc4, 0xfc, 0x88, 0xf8, 0xb0, 0xf0, 0xc8, 0xf8, 0x64, 0x7c, 0x1c, 0x1c, 0x00, 0x00,
+    0x00, 0x00, 0x78, 0x78, 0xc4, 0xfc, 0x88, 0xf8, 0xb0, 0xf0, 0xc8, 0xf8, 0x64, 0x7c, 0x1c, 0x1c,
+    0xf0, 0xf0, 0x0c, 0xfc, 0x06, 0xfe, 0x23, 0xff, 0x06, 0xfe, 0x0c, 0xfc, 0xf0, 0xf0, 0x40, 0xc0,
+    0xff, 0xff, 0x80, 0xff, 0x80, 0xff, 0x90, 0xff, 0x80, 0xff, 0x80, 0xff, 0xff, 0xff, 0x29, 0x3f,
+};
+
+static const uint16_t asset_cell_index[84] = {
+    0x0000, 0x8000, 0x0001, 0x8001, 0x0002, 0x8002, 0x0003, 0x0004, 0x0000, 0x8000, 0x0005, 0x0006, 0x0007, 0x0008, 0x0009, 0x8009,
+    0x000a, 0x000b, 0x000c, 0x000d, 0x800b, 0x800a, 0x800d, 0x800c, 0x000e, 0x000f, 0x0010, 0x0011, 0x000e, 0x000f, 0x0012, 0x0013,
+    0x0014, 0x0015, 0x0016, 0x0017, 0x0018, 0x0019, 0x001a, 0x001b, 0x001c, 0x001c, 0x001d, 0x001e, 0x001c, 0x001c, 0x001f, 0x0020,
+    0x0021, 0x0022, 0x0023, 0x001c, 0x0024, 0x0025, 0x0026, 0x0027, 0x0028, 0x001c, 0x0029, 0x002a, 0x002b, 0x002c, 0x002d, 0x001c,
+    0x002e, 0x002f, 0x0030, 0x0031, 0x0032, 0x001c, 0x001c, 0x001c, 0x001c, 0x001c, 0x001c, 0x001c, 0x0033, 0x0034, 0x0035, 0x0036,
+    0x0037, 0x8037, 0x0038, 0x8038,
+};
+
+const MaskedSprite asset_sprites[ASSET_COUNT] = {
+    [ASSET_TRAINER_BACKWARD_STANDING] = {16, 16, asset_cell_index + 0, asset_cells},
+    [ASSET_TRAINER_BACKWARDS_WALKING_LEFT] = {16, 16, asset_cell_index + 4, asset_cells},
+    [ASSET_TRAINER_BACKWARDS_WALKING_RIGHT] = {16, 16, asset_cell_index + 8, asset_cells},
+    [ASSET_TRAINER_FORWARD_NORMAL] = {16, 16, asset_cell_index + 12, asset_cells},
+    [ASSET_TRAINER_FRONT_WALKING_LEFT] = {16, 16, asset_cell_index + 16, asset_cells},
+    [ASSET_TRAINER_FRONT_WALKING_RIGHT] = {16, 16, asset_cell_index + 20, asset_cells},
+    [ASSET_TRAINER_LEFT_STANDING] = {16, 16, asset_cell_index + 24, asset_cells},
+    [ASSET_TRAINER_LEFT_WALKING] = {16, 16, asset_cell_index + 28, asset_cells},
+    [ASSET_TRAINER_RIGHT_STANDING] = {16, 16, asset_cell_index + 32, asset_cells},
+    [ASSET_TRAINER_RIGHT_WALKING] = {16, 16, asset_cell_index + 36, asset_cells},
+    [ASSET_BULBASAUR] = {42, 42, asset_cell_index + 40, asset_cells},
+    [ASSET_TILE_GRASS] = {16, 16, asset_cell_index + 76, asset_cells},
+    [ASSET_TILE_FENCE_TOP_BOTTOM] = {16, 16, asset_cell_index + 80, asset_cells},
+};
@@ -0,0 +1,27 @@
+// asset_data.h - Generated by tools/gen_assets.py, do not edit
+#ifndef ASSET_DATA_H
+#define ASSET_DATA_H
+
+#include "masked_sprite.h"
+
+// IDs are stable, see tools/asset_ids.txt
+typedef enum {
+    ASSET_TRAINER_BACKWARD_STANDING, // 16x16
+    ASSET_TRAINER_BACKWARDS_WALKING_LEFT, // 16x16
+    ASSET_TRAINER_BACKWARDS_WALKING_RIGHT, // 16x16
+    ASSET_TRAINER_FORWARD_NORMAL, // 16x16
+    ASSET_TRAINER_FRONT_WALKING_LEFT, // 16x16
+    ASSET_TRAINER_FRONT_WALKING_RIGHT, // 16x16
+    ASSET_TRAINER_LEFT_STANDING, // 16x16
+    ASSET_TRAINER_LEFT_WALKING, // 16x16
+    ASSET_TRAINER_RIGHT_STANDING, // 16x16
+    ASSET_TRAINER_RIGHT_WALKING, // 16x16
+    ASSET_BULBASAUR, // 42x42
+    ASSET_TILE_GRASS, // 16x16
+    ASSET_TILE_FENCE_TOP_BOTTOM, // 16x16
+    ASSET_COUNT
+} AssetId;
+
+extern const MaskedSprite asset_sprites[ASSET_COUNT];
+
+#endif // ASSET_DATA_H
@@ -0,0 +1,11 @@
+// assets.h - Sprites packed from images/ by tools/gen_assets.py
+#ifndef ASSETS_H
+#define ASSETS_H
+
+#include "asset_data.h"
+
+static inline const MaskedSprite* asset_sprite(AssetId id) {
+    return &asset_sprites[id];
+}
+
+#endif // ASSETS_H
@@ -0,0 +1,113 @@
+#include "battle.h"
+#include <stdlib.h>
+
+static void push_event(BattleEventQueue* queue, BattleEventType type, BattleSide side, int value) {
+    if(queue->count == BATTLE_EVENT_MAX) return;
+    queue->events[queue->count++] = (BattleEvent){type, side, (uint16_t)value};
+}
+
+int battle_pick_move(const Pokemon* pokemon) {
+    int valid_moves = 0;
+    for(int i = 0; i < 4; i++) {
+        if(pokemon->moves[i] != NULL) valid_moves++;
+    }
+    if(valid_moves == 0) return -1;
+
+    int pick = rand() % valid_moves;
+    for(int i = 0; i < 4; i++) {
+        if(pokemon->moves[i] != NULL && pick-- == 0) return i;
+    }
+    return -1;
+}
+
+int battle_pick_best_move(const Pokemon* attacker, const Pokemon* defender) {
+    DamageOutcome outcomes[4];
+    damage_outcomes(attacker, defender, outcomes);
+
+    int best = -1;
+    int64_t best_score = 0;
+    for(int i = 0; i < 4; i++) {
+        const Move* move = attacker->moves[i];
+        if(move == NULL || outcomes[i].max_damage == 0) continue;
+
+        // One-hit KOs dominate two-hit KOs, which dominate raw damage
+        int64_t score = ((int64_t)outcomes[i].ko_rolls * 1024 * 1024 + (int64_t)outcomes[i].ko2_rolls * 1024 +
+                         outcomes[i].min_damage + outcomes[i].max_damage) * move->accuracy;
+        if(score > best_score) {
+            best = i;
+            best_score = score;
+        }
+    }
+    return best >= 0 ? best : battle_pick_move(attacker);
+}
+
+// Sleep counts down and paralysis stops one move in four, false when
+// attacker does not get to move this turn
+static bool status_lets_move(BattleEventQueue* queue, BattleRng* rng, BattleSide side, Pokemon* attacker) {
+    switch(attacker->status) {
+        case EFFECT_SLEEP:
+            if(--attacker->status_turns > 0) {
+                push_event(queue, BattleEventCantMove, side, EFFECT_SLEEP);
+            } else {
+                attacker->status = EFFECT_NONE;
+                push_event(queue, BattleEventWokeUp, side, 0);
+            }
+            return false;
+        case EFFECT_PARALYZE:
+            if(battle_rng_below(rng, 4) == 0) {
+                push_event(queue, BattleEventCantMove, side, EFFECT_PARALYZE);
+                return false;
+            }
+            return true;
+        default:
+            return true;
+    }
+}
+
+static void use_move(BattleEventQueue* queue, BattleRng* rng, BattleSide side, Pokemon* attacker, Pokemon* defender, int slot) {
+    const Move* move = attacker->moves[slot];
+    BattleSide target = side == BattleSidePlayer ? BattleSideOpponent : BattleSidePlayer;
+
+    push_event(queue, BattleEventMoveUsed, side, slot);
+
+    if(battle_rng_below(rng, 100) >= move->accuracy) {
+        push_event(queue, BattleEventMiss, side, 0);
+        return;
+    }
+
+    bool affected = false;
+    if(move->power > 0) {
+        int damage = calculate_damage_roll(move, attacker, defender, battle_rng_below(rng, DAMAGE_ROLLS));
+        defender->current_hp -= damage;
+        if(defender->current_hp < 0) defender->current_hp = 0;
+        push_event(queue, BattleEventDamage, target, damage);
+        affected = true;
+    }
+
+    // A fainted Pokemon keeps no status and one status at a time
+    if(move->effect != EFFECT_NONE && defender->current_hp > 0 && defender->status == EFFECT_NONE &&
+       battle_rng_below(rng, 100) < move->effect_chance) {
+        defender->status = move->effect;
+        // Sleep takes 1 to 3 of the sleeper's turns, the last one wakes it
+        if(move->effect == EFFECT_SLEEP) defender->status_turns = (uint8_t)(1 + battle_rng_below(rng, 3));
+        push_event(queue, BattleEventStatus, target, move->effect);
+        affected = true;
+    }
+
+    if(!affected) push_event(queue, BattleEventNoEffect, target, 0);
+    if(defender->current_hp == 0) push_event(queue, BattleEventFaint, target, 0);
+}
+
+void battle_resolve_move(BattleEventQueue* queue, BattleRng* rng, BattleSide side, Pokemon* attacker, Pokemon* defender, int slot) {
+    if(status_lets_move(queue, rng, side, attacker)) use_move(queue, rng, side, attacker, defender, slot);
+
+    // Burn and poison hurt at the end of the Pokemon's own turn
+    if((attacker->status == EFFECT_BURN || attacker->status == EFFECT_POISON) && attacker->current_hp > 0) {
+        int damage = attacker->max_hp / 8;
+        if(damage < 1) damage = 1;
+        attacker->current_hp -= damage;
+        if(attacker->current_hp < 0) attacker->current_hp = 0;
+        push_event(queue, BattleEventHurt, side, damage);
+        if(attacker->current_hp == 0) push_event(queue, BattleEventFaint, side, 0);
+    }
+}
@@ -0,0 +1,91 @@
+// battle.h - Turn resolution as a stream of typed events, no text involved
+#ifndef BATTLE_H
+#define BATTLE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "pokemon.h"
+
+#define BATTLE_EVENT_MAX 8 // One resolved move produces at most 6
+
+typedef enum {
+    BattleSidePlayer,
+    BattleSideOpponent,
+} BattleSide;
+
+typedef enum {
+    BattleEventMoveUsed, // side used the move in slot value
+    BattleEventMiss,     // side's move missed
+    BattleEventDamage,   // side took value damage
+    BattleEventNoEffect, // side was not affected
+    BattleEventStatus,   // side got MoveEffect value
+    BattleEventCantMove, // side's MoveEffect value kept it from moving
+    BattleEventWokeUp,   // side woke up, which took its turn
+    BattleEventHurt,     // side took value damage from its burn or poison
+    BattleEventFaint,    // side fainted
+} BattleEventType;
+
+typedef struct {
+    uint8_t type; // BattleEventType
+    uint8_t side; // BattleSide the event is about
+    uint16_t value;
+} BattleEvent;
+
+// Events of the current turn in order; the UI reads them one dialog page
+// at a time, a headless caller can simply drop them.
+typedef struct {
+    BattleEvent events[BATTLE_EVENT_MAX];
+    uint8_t count;
+    uint8_t next;
+} BattleEventQueue;
+
+static inline void battle_events_clear(BattleEventQueue* queue) {
+    queue->count = 0;
+    queue->next = 0;
+}
+
+// Next unread event, NULL once the turn has been shown
+static inline const BattleEvent* battle_events_next(BattleEventQueue* queue) {
+    return queue->next < queue->count ? &queue->events[queue->next++] : NULL;
+}
+
+// Rolls that decide a battle: xorshift32, so two devices seeded alike
+// resolve every turn alike
+typedef struct {
+    uint32_t state;
+} BattleRng;
+
+// A zero seed is replaced, xorshift would stay at zero
+static inline void battle_rng_seed(BattleRng* rng, uint32_t seed) {
+    rng->state = seed ? seed : 0x9E3779B9u;
+}
+
+static inline uint32_t battle_rng_next(BattleRng* rng) {
+    uint32_t x = rng->state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return rng->state = x;
+}
+
+// 0..range-1, scaled rather than taken modulo
+static inline int battle_rng_below(BattleRng* rng, int range) {
+    return (int)(((uint64_t)battle_rng_next(rng) * (uint32_t)range) >> 32);
+}
+
+// Random non-empty move slot, -1 if the Pokemon has no moves
+int battle_pick_move(const Pokemon* pokemon);
+
+// Trainer choice: the slot most likely to knock defender out in one hit,
+// then in two, then the one with the most expected damage; accuracy is
+// weighed in. Falls back to battle_pick_move when nothing deals damage.
+int battle_pick_best_move(const Pokemon* attacker, const Pokemon* defender);
+
+// attacker (on side) takes its turn with the move in slot on defender:
+// sleep and paralysis may skip the move, then accuracy, damage, status
+// effect and fainting are applied, and a burned or poisoned attacker loses
+// 1/8 of its HP at the end. All of it is appended to queue. Every roll
+// comes from rng, side only labels the events.
+void battle_resolve_move(BattleEventQueue* queue, BattleRng* rng, BattleSide side, Pokemon* attacker, Pokemon* defender, int slot);
+
+#endif // BATTLE_H
@@ -0,0 +1,59 @@
+#include "bench.h"
+
+#ifdef FLIPPER_MON_BENCH
+
+#include <furi.h>
+#include <furi_hal.h>
+#include <storage/storage.h>
+#include <stdio.h>
+
+void bench_run(BenchSuite* suite, const char* name, BenchFn fn, void* ctx, uint32_t iterations,
+               const volatile uint32_t* canvas_calls) {
+    if(suite->count == BENCH_MAX_RESULTS || iterations == 0) return;
+
+    // Warm caches and lazily built state so the first call does not skew the average
+    fn(ctx);
+
+    uint32_t calls_before = canvas_calls ? *canvas_calls : 0;
+    uint32_t start = DWT->CYCCNT;
+    for(uint32_t i = 0; i < iterations; i++) {
+        fn(ctx);
+    }
+    uint32_t cycles = DWT->CYCCNT - start;
+    uint32_t calls = canvas_calls ? *canvas_calls - calls_before : 0;
+
+    BenchResult* result = &suite->results[suite->count++];
+    result->name = name;
+    result->iterations = iterations;
+    result->ns_per_op = (uint32_t)((uint64_t)cycles * 1000 / furi_hal_cortex_instructions_per_microsecond() / iterations);
+    result->canvas_calls_per_op = calls / iterations;
+
+    FURI_LOG_I("Bench", "%s: %lu ns/op, %lu canvas calls/op", name, result->ns_per_op, result->canvas_calls_per_op);
+}
+
+bool bench_write_csv(const BenchSuite* suite, const char* path) {
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    bool written = false;
+
+    if(storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+        char line[64];
+        int length = snprintf(line, sizeof(line), "name,iterations,ns_per_op,canvas_calls_per_op\n");
+        written = storage_file_write(file, line, length) == (size_t)length;
+
+        for(int i = 0; i < suite->count && written; i++) {
+            const BenchResult* result = &suite->results[i];
+            length = snprintf(line, sizeof(line), "%s,%lu,%lu,%lu\n", result->name, result->iterations,
+                              result->ns_per_op, result->canvas_calls_per_op);
+            written = storage_file_write(file, line, length) == (size_t)length;
+        }
+        storage_file_close(file);
+    }
+
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+    if(!written) FURI_LOG_E("Bench", "Could not write %s", path);
+    return written;
+}
+
+#endif // FLIPPER_MON_BENCH
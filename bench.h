@@ -0,0 +1,32 @@
+// bench.h - On-device micro-benchmark harness, built with -DFLIPPER_MON_BENCH
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define BENCH_MAX_RESULTS 16
+
+typedef void (*BenchFn)(void* ctx);
+
+typedef struct {
+    const char* name;
+    uint32_t iterations;
+    uint32_t ns_per_op;
+    uint32_t canvas_calls_per_op; // Only counted where the draw code is instrumented
+} BenchResult;
+
+typedef struct {
+    BenchResult results[BENCH_MAX_RESULTS];
+    int count;
+} BenchSuite;
+
+// Time fn over iterations calls (after one warm-up call) and append the result.
+// canvas_calls points at a counter the measured code bumps, or NULL.
+void bench_run(BenchSuite* suite, const char* name, BenchFn fn, void* ctx, uint32_t iterations,
+               const volatile uint32_t* canvas_calls);
+
+// Write the suite as CSV (name,iterations,ns_per_op,canvas_calls_per_op) so runs can be diffed
+bool bench_write_csv(const BenchSuite* suite, const char* path);
+
+#endif // BENCH_H
@@ -0,0 +1,80 @@
+#include "bg_cache.h"
+#include <string.h>
+
+#define BG_CACHE_PAGES (BG_CACHE_HEIGHT / 8)
+
+void bg_cache_invalidate(BgCache* cache) {
+    cache->valid = false;
+}
+
+// The display buffer stores each 8 pixel tall page as one byte per column
+// (bit 0 is the top row), so a whole 64 pixel column fits in one word.
+static inline uint64_t read_column(const uint8_t* pixels, int x) {
+    uint64_t column = 0;
+    for(int page = 0; page < BG_CACHE_PAGES; page++) {
+        column |= (uint64_t)pixels[page * BG_CACHE_WIDTH + x] << (page * 8);
+    }
+    return column;
+}
+
+static inline void write_column(uint8_t* pixels, int x, uint64_t column) {
+    for(int page = 0; page < BG_CACHE_PAGES; page++) {
+        pixels[page * BG_CACHE_WIDTH + x] = (uint8_t)(column >> (page * 8));
+    }
+}
+
+// Move the cached image so that pixel (x + dx, y + dy) lands on (x, y).
+// Pixels scrolled in from outside the cache are cleared.
+static void shift_pixels(uint8_t* pixels, int dx, int dy) {
+    int start = dx >= 0 ? 0 : BG_CACHE_WIDTH - 1;
+    int step = dx >= 0 ? 1 : -1;
+
+    for(int x = start; x >= 0 && x < BG_CACHE_WIDTH; x += step) {
+        int src_x = x + dx;
+        uint64_t column = 0;
+        if(src_x >= 0 && src_x < BG_CACHE_WIDTH) {
+            column = read_column(pixels, src_x);
+            column = dy >= 0 ? column >> dy : column << -dy;
+        }
+        write_column(pixels, x, column);
+    }
+}
+
+void bg_cache_draw(BgCache* cache, Canvas* canvas, int map_index, int camera_x, int camera_y, BgCacheDrawRect draw_rect, void* ctx) {
+    uint8_t* screen = canvas_get_buffer(canvas);
+    int dx = camera_x - cache->camera_x;
+    int dy = camera_y - cache->camera_y;
+
+    bool full_redraw = !cache->valid || cache->map_index != map_index ||
+                       canvas_get_buffer_size(canvas) != BG_CACHE_SIZE ||
+                       dx <= -BG_CACHE_WIDTH || dx >= BG_CACHE_WIDTH ||
+                       dy <= -BG_CACHE_HEIGHT || dy >= BG_CACHE_HEIGHT;
+
+    canvas_set_color(canvas, ColorBlack);
+
+    if(full_redraw) {
+        canvas_clear(canvas);
+        draw_rect(canvas, camera_x, camera_y, 0, 0, BG_CACHE_WIDTH, BG_CACHE_HEIGHT, ctx);
+        if(canvas_get_buffer_size(canvas) == BG_CACHE_SIZE) {
+            memcpy(cache->pixels, screen, BG_CACHE_SIZE);
+            cache->valid = true;
+        }
+    } else if(dx == 0 && dy == 0) {
+        memcpy(screen, cache->pixels, BG_CACHE_SIZE);
+    } else {
+        shift_pixels(cache->pixels, dx, dy);
+        memcpy(screen, cache->pixels, BG_CACHE_SIZE);
+
+        // Only the strips that scrolled into view need real tile drawing
+        if(dx > 0) draw_rect(canvas, camera_x, camera_y, BG_CACHE_WIDTH - dx, 0, dx, BG_CACHE_HEIGHT, ctx);
+        if(dx < 0) draw_rect(canvas, camera_x, camera_y, 0, 0, -dx, BG_CACHE_HEIGHT, ctx);
+        if(dy > 0) draw_rect(canvas, camera_x, camera_y, 0, BG_CACHE_HEIGHT - dy, BG_CACHE_WIDTH, dy, ctx);
+        if(dy < 0) draw_rect(canvas, camera_x, camera_y, 0, 0, BG_CACHE_WIDTH, -dy, ctx);
+
+        memcpy(cache->pixels, screen, BG_CACHE_SIZE);
+    }
+
+    cache->map_index = map_index;
+    cache->camera_x = camera_x;
+    cache->camera_y = camera_y;
+}
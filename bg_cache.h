@@ -0,0 +1,34 @@
+// bg_cache.h - Cached exploration background that scrolls by shifting pixels
+#ifndef BG_CACHE_H
+#define BG_CACHE_H
+
+#include <gui/gui.h>
+
+// Screen geometry of the Flipper display (1 bpp, 8 pixel tall pages)
+#define BG_CACHE_WIDTH  128
+#define BG_CACHE_HEIGHT 64
+#define BG_CACHE_SIZE   (BG_CACHE_WIDTH * BG_CACHE_HEIGHT / 8)
+
+// Draws every background tile touching the screen rectangle (x, y, w, h).
+// Tiles may spill outside the rectangle, they only ever overwrite pixels
+// that already hold the same content.
+typedef void (*BgCacheDrawRect)(Canvas* canvas, int camera_x, int camera_y, int x, int y, int w, int h, void* ctx);
+
+// Cached copy of the last rendered background and the camera it was drawn at
+typedef struct {
+    uint8_t pixels[BG_CACHE_SIZE];
+    int camera_x;
+    int camera_y;
+    int map_index;
+    bool valid;
+} BgCache;
+
+// Force a full redraw on the next frame
+void bg_cache_invalidate(BgCache* cache);
+
+// Put the background for the given camera into the canvas. When the camera
+// only moved a few pixels since the last frame the cached pixels are shifted
+// and only the newly exposed strips are drawn through draw_rect.
+void bg_cache_draw(BgCache* cache, Canvas* canvas, int map_index, int camera_x, int camera_y, BgCacheDrawRect draw_rect, void* ctx);
+
+#endif // BG_CACHE_H
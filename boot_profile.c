@@ -0,0 +1,40 @@
+#include "boot_profile.h"
+#include <furi.h>
+#include <furi_hal.h>
+#include <string.h>
+
+static const char* const phase_names[BootPhaseCount] = {
+    "alloc", "map", "scene", "gui", "first_frame", "warmup",
+};
+
+void boot_profile_start(BootProfile* boot) {
+    memset(boot, 0, sizeof(BootProfile));
+    boot->start = DWT->CYCCNT;
+}
+
+void boot_profile_mark(BootProfile* boot, BootPhase phase) {
+    if(boot->reached[phase]) return;
+    boot->end[phase] = DWT->CYCCNT;
+    boot->reached[phase] = true;
+}
+
+void boot_profile_log(const BootProfile* boot) {
+    uint32_t per_us = furi_hal_cortex_instructions_per_microsecond();
+    uint32_t previous = boot->start;
+
+    for(int i = 0; i < BootPhaseCount; i++) {
+        if(!boot->reached[i]) continue;
+        // Unsigned differences stay right across one counter wrap
+        uint32_t phase_us = (boot->end[i] - previous) / per_us;
+        uint32_t total_us = (boot->end[i] - boot->start) / per_us;
+        FURI_LOG_I("Boot", "%-11s %6lu us, %6lu us since entry", phase_names[i], phase_us, total_us);
+        previous = boot->end[i];
+    }
+
+    if(boot->reached[BootPhaseFirstFrame]) {
+        uint32_t first_frame_us = (boot->end[BootPhaseFirstFrame] - boot->start) / per_us;
+        if(first_frame_us > BOOT_FIRST_FRAME_BUDGET_US) {
+            FURI_LOG_W("Boot", "First frame after %lu us, budget is %lu us", first_frame_us, (uint32_t)BOOT_FIRST_FRAME_BUDGET_US);
+        }
+    }
+}
@@ -0,0 +1,41 @@
+// boot_profile.h - Launch timeline: when each startup phase finished
+#ifndef BOOT_PROFILE_H
+#define BOOT_PROFILE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define BOOT_FIRST_FRAME_BUDGET_US 50000 // From app_main entry to the first finished draw
+
+typedef enum {
+    BootPhaseAlloc,      // Event queue and scene arena
+    BootPhaseMap,        // Current map tiles and bitsets
+    BootPhaseScene,      // Scripts, NPCs and the entry cutscene of the current map
+    BootPhaseGui,        // View port and logic timer
+    BootPhaseFirstFrame, // First draw callback returned
+    BootPhaseWarmup,     // Deferred work done after the first frame
+    BootPhaseCount
+} BootPhase;
+
+// Cycle counter stamps, each phase is stamped once. The first frame is
+// marked on the GUI thread, every other phase on the game thread.
+typedef struct {
+    uint32_t start;
+    uint32_t end[BootPhaseCount];
+    volatile bool reached[BootPhaseCount];
+} BootProfile;
+
+// Call first thing in app_main
+void boot_profile_start(BootProfile* boot);
+
+// Stamp the end of a phase, repeated marks keep the first stamp
+void boot_profile_mark(BootProfile* boot, BootPhase phase);
+
+static inline bool boot_profile_reached(const BootProfile* boot, BootPhase phase) {
+    return boot->reached[phase];
+}
+
+// Log every reached phase: its own duration and the time since entry
+void boot_profile_log(const BootProfile* boot);
+
+#endif // BOOT_PROFILE_H
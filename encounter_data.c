@@ -0,0 +1,24 @@
+// encounter_data.c - Generated by tools/gen_encounters.py, do not edit
+#include "encounters.h"
+
+static const EncounterSlot route_1_grass_slots[] = {
+    {POKEMON_BULBASAUR, 3, 5}, // weight 1
+    {POKEMON_PIDGEY, 3, 5}, // weight 1
+    {POKEMON_CHARMANDER, 3, 5}, // weight 1
+};
+static const uint8_t route_1_grass_threshold[] = {255, 255, 255};
+static const uint8_t route_1_grass_alias[] = {0, 1, 2};
+
+static const EncounterSlot pallet_town_grass_slots[] = {
+    {POKEMON_BULBASAUR, 3, 5}, // weight 1
+    {POKEMON_PIDGEY, 3, 5}, // weight 1
+    {POKEMON_CHARMANDER, 3, 5}, // weight 1
+};
+static const uint8_t pallet_town_grass_threshold[] = {255, 255, 255};
+static const uint8_t pallet_town_grass_alias[] = {0, 1, 2};
+
+const EncounterZone encounter_zones[ENCOUNTER_ZONE_COUNT] = {
+    [ENCOUNTER_ZONE_NONE] = {0, 0, NULL, NULL, NULL},
+    [ENCOUNTER_ZONE_ROUTE_1_GRASS] = {30, 3, route_1_grass_slots, route_1_grass_threshold, route_1_grass_alias},
+    [ENCOUNTER_ZONE_PALLET_TOWN_GRASS] = {30, 3, pallet_town_grass_slots, pallet_town_grass_threshold, pallet_town_grass_alias},
+};
@@ -0,0 +1,13 @@
+// encounter_data.h - Generated by tools/gen_encounters.py, do not edit
+#ifndef ENCOUNTER_DATA_H
+#define ENCOUNTER_DATA_H
+
+// Encounter zone IDs as stored in the map's zone nibbles
+typedef enum {
+    ENCOUNTER_ZONE_NONE,
+    ENCOUNTER_ZONE_ROUTE_1_GRASS,
+    ENCOUNTER_ZONE_PALLET_TOWN_GRASS,
+    ENCOUNTER_ZONE_COUNT
+} EncounterZoneId;
+
+#endif // ENCOUNTER_DATA_H
@@ -0,0 +1,47 @@
+#include "encounters.h"
+#include "map_bits.h"
+#include <stdlib.h>
+
+_Static_assert(ENCOUNTER_ZONE_COUNT <= MAP_BITS_ZONE_COUNT, "Zone IDs must fit the map's encounter nibbles");
+
+// Scale a 16 bit random value into 0..range-1 without a division
+static inline int random_below(int range) {
+    return (int)(((uint32_t)(rand() & 0xFFFF) * (uint32_t)range) >> 16);
+}
+
+void encounter_use_repel(EncounterState* state, uint16_t steps, uint8_t lead_level) {
+    state->repel_steps = steps;
+    state->repel_level = lead_level;
+}
+
+void encounter_start_grace(EncounterState* state, uint8_t steps) {
+    state->grace_steps = steps;
+}
+
+bool encounter_roll(EncounterState* state, uint8_t zone_id, PokemonSpecies* species, int* level) {
+    bool repelled = state->repel_steps > 0;
+    if(state->repel_steps > 0) state->repel_steps--;
+
+    if(state->grace_steps > 0) {
+        state->grace_steps--;
+        return false;
+    }
+
+    if(zone_id == ENCOUNTER_ZONE_NONE || zone_id >= ENCOUNTER_ZONE_COUNT) return false;
+    const EncounterZone* zone = &encounter_zones[zone_id];
+
+    if(random_below(100) >= zone->rate) return false;
+
+    // Alias method: a uniform column plus a biased coin picks the slot
+    uint32_t r = (uint32_t)rand();
+    int column = (int)(((r & 0xFFFF) * zone->slot_count) >> 16);
+    uint8_t coin = (r >> 16) & 0xFF;
+    const EncounterSlot* slot = &zone->slots[coin < zone->alias_threshold[column] ? column : zone->alias[column]];
+
+    int wild_level = slot->min_level + random_below(slot->level_span);
+    if(repelled && wild_level < state->repel_level) return false;
+
+    *species = (PokemonSpecies)slot->species;
+    *level = wild_level;
+    return true;
+}
@@ -0,0 +1,48 @@
+// encounters.h - Weighted wild encounter zones sampled with alias tables
+#ifndef ENCOUNTERS_H
+#define ENCOUNTERS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "pokemon.h"
+#include "encounter_data.h"
+
+// One species that can appear in a zone
+typedef struct {
+    uint8_t species;    // PokemonSpecies
+    uint8_t min_level;
+    uint8_t level_span; // max_level - min_level + 1
+} EncounterSlot;
+
+// Flash resident zone shared by every tile that carries its ID.
+// Slot i is kept when a random byte is below alias_threshold[i], otherwise
+// alias[i] is used (Vose's alias method, built by tools/gen_encounters.py).
+typedef struct {
+    uint8_t rate;       // Percent chance of an encounter per step
+    uint8_t slot_count;
+    const EncounterSlot* slots;
+    const uint8_t* alias_threshold;
+    const uint8_t* alias;
+} EncounterZone;
+
+extern const EncounterZone encounter_zones[ENCOUNTER_ZONE_COUNT];
+
+// Player side encounter suppression
+typedef struct {
+    uint16_t repel_steps; // Steps left on an active repel
+    uint8_t repel_level;  // While repelled, wild Pokemon below this level stay away
+    uint8_t grace_steps;  // Steps left without any encounter, e.g. after a battle
+} EncounterState;
+
+// Keep wild Pokemon weaker than lead_level away for the next steps
+void encounter_use_repel(EncounterState* state, uint16_t steps, uint8_t lead_level);
+
+// Suppress every encounter for the next steps
+void encounter_start_grace(EncounterState* state, uint8_t steps);
+
+// Roll for an encounter after a step into the given zone. Returns true and
+// fills species and level if a wild Pokemon appears.
+bool encounter_roll(EncounterState* state, uint8_t zone_id, PokemonSpecies* species, int* level);
+
+#endif // ENCOUNTERS_H
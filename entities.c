@@ -0,0 +1,179 @@
+#include "entities.h"
+#include <string.h>
+
+#define ENTITY_GIVE_UP_TICKS 90 // A blocked entity drops its path after this many logic steps
+
+static const int8_t dir_dx[5] = {0, 0, 1, 0, -1};
+static const int8_t dir_dy[5] = {0, -1, 0, 1, 0};
+
+static inline void set_cell(uint32_t* rows, uint32_t* cols, int x, int y, bool value) {
+    if(value) {
+        rows[y] |= 1u << x;
+        cols[x] |= 1u << y;
+    } else {
+        rows[y] &= ~(1u << x);
+        cols[x] &= ~(1u << y);
+    }
+}
+
+void entity_pool_clear(EntityPool* pool) {
+    memset(pool, 0, sizeof(EntityPool));
+}
+
+int entity_pool_add(EntityPool* pool, const NpcSpawn* spawn, bool defeated) {
+    if(pool->count == ENTITY_MAX) return ENTITY_NONE;
+    if(spawn->x >= MAP_WIDTH || spawn->y >= MAP_HEIGHT) return ENTITY_NONE;
+
+    int i = pool->count++;
+    pool->x[i] = spawn->x;
+    pool->y[i] = spawn->y;
+    pool->direction[i] = spawn->direction;
+    pool->vision[i] = spawn->vision;
+    pool->party[i] = spawn->party;
+    pool->script[i] = spawn->script;
+    pool->defeat_flag[i] = spawn->defeat_flag;
+    pool->flags[i] = 0;
+    pool->step_phase[i] = 0;
+    pool->blocked_ticks[i] = 0;
+    pool->path_len[i] = 0;
+    pool->path_pos[i] = 0;
+
+    set_cell(pool->occupied_rows, pool->occupied_cols, spawn->x, spawn->y, true);
+    if(spawn->vision > 0 && !defeated) {
+        pool->flags[i] |= ENTITY_FLAG_WATCHING;
+        set_cell(pool->watch_rows, pool->watch_cols, spawn->x, spawn->y, true);
+    }
+    return i;
+}
+
+int entity_pool_at(const EntityPool* pool, int x, int y) {
+    if(!entity_pool_occupied(pool, x, y)) return ENTITY_NONE;
+    for(int i = 0; i < pool->count; i++) {
+        if(pool->x[i] == x && pool->y[i] == y) return i;
+    }
+    return ENTITY_NONE;
+}
+
+void entity_pool_set_path(EntityPool* pool, int index, const uint8_t* directions, int length) {
+    if(length > ENTITY_PATH_MAX) length = ENTITY_PATH_MAX;
+    memset(pool->path[index], 0, sizeof(pool->path[index]));
+    for(int i = 0; i < length; i++) {
+        pool->path[index][i / 4] |= ((directions[i] - 1) & 3) << ((i % 4) * 2);
+    }
+    pool->path_len[index] = length;
+    pool->path_pos[index] = 0;
+    pool->blocked_ticks[index] = 0;
+}
+
+bool entity_pool_is_idle(const EntityPool* pool, int index) {
+    return !(pool->flags[index] & ENTITY_FLAG_MOVING) && pool->path_pos[index] >= pool->path_len[index];
+}
+
+void entity_pool_stop_watching(EntityPool* pool, int index) {
+    if(!(pool->flags[index] & ENTITY_FLAG_WATCHING)) return;
+    pool->flags[index] &= ~ENTITY_FLAG_WATCHING;
+    set_cell(pool->watch_rows, pool->watch_cols, pool->x[index], pool->y[index], false);
+}
+
+static inline int path_direction(const EntityPool* pool, int index, int step) {
+    return ((pool->path[index][step / 4] >> ((step % 4) * 2)) & 3) + 1;
+}
+
+int entity_pool_update(EntityPool* pool, const MapBits* bits, int player_x, int player_y, int walk_steps, uint8_t* arrived) {
+    int arrived_count = 0;
+
+    for(int i = 0; i < pool->count; i++) {
+        if(pool->flags[i] & ENTITY_FLAG_MOVING) {
+            if(--pool->step_phase[i] > 0) continue;
+
+            // Landed: let go of the cell the step started from
+            int dir = pool->direction[i];
+            int from_x = pool->x[i] - dir_dx[dir];
+            int from_y = pool->y[i] - dir_dy[dir];
+            pool->flags[i] &= ~ENTITY_FLAG_MOVING;
+            set_cell(pool->occupied_rows, pool->occupied_cols, from_x, from_y, false);
+            if(pool->flags[i] & ENTITY_FLAG_WATCHING) {
+                set_cell(pool->watch_rows, pool->watch_cols, from_x, from_y, false);
+                set_cell(pool->watch_rows, pool->watch_cols, pool->x[i], pool->y[i], true);
+            }
+            arrived[arrived_count++] = i;
+            continue;
+        }
+
+        if(pool->path_pos[i] >= pool->path_len[i]) {
+            pool->path_len[i] = 0;
+            pool->path_pos[i] = 0;
+            continue;
+        }
+
+        int dir = path_direction(pool, i, pool->path_pos[i]);
+        int next_x = pool->x[i] + dir_dx[dir];
+        int next_y = pool->y[i] + dir_dy[dir];
+        pool->direction[i] = dir;
+
+        if(map_bits_is_solid(bits, next_x, next_y) || entity_pool_occupied(pool, next_x, next_y) ||
+           (next_x == player_x && next_y == player_y)) {
+            if(++pool->blocked_ticks[i] >= ENTITY_GIVE_UP_TICKS) {
+                pool->path_len[i] = 0;
+                pool->path_pos[i] = 0;
+            }
+            continue;
+        }
+
+        set_cell(pool->occupied_rows, pool->occupied_cols, next_x, next_y, true);
+        pool->x[i] = next_x;
+        pool->y[i] = next_y;
+        pool->path_pos[i]++;
+        pool->blocked_ticks[i] = 0;
+        pool->flags[i] |= ENTITY_FLAG_MOVING;
+        pool->step_phase[i] = walk_steps > 0 ? walk_steps : 1;
+    }
+
+    return arrived_count;
+}
+
+// True if no solid or occupied cell lies strictly between a and b on a line
+static inline bool span_clear(uint32_t solid, uint32_t occupied, int a, int b) {
+    int lo = (a < b ? a : b) + 1;
+    int hi = (a < b ? b : a) - 1;
+    if(lo > hi) return true;
+    return ((solid | occupied) & map_bits_span_mask(lo, hi)) == 0;
+}
+
+bool entity_pool_can_see(const EntityPool* pool, const MapBits* bits, int index, int px, int py) {
+    if(!(pool->flags[index] & ENTITY_FLAG_WATCHING)) return false;
+
+    int ex = pool->x[index];
+    int ey = pool->y[index];
+    int range = pool->vision[index];
+
+    switch(pool->direction[index]) {
+        case 1:
+            return px == ex && py < ey && ey - py <= range &&
+                   span_clear(map_bits_column(bits, ex), pool->occupied_cols[ex], py, ey);
+        case 2:
+            return py == ey && px > ex && px - ex <= range &&
+                   span_clear(map_bits_row(bits, ey), pool->occupied_rows[ey], px, ex);
+        case 3:
+            return px == ex && py > ey && py - ey <= range &&
+                   span_clear(map_bits_column(bits, ex), pool->occupied_cols[ex], py, ey);
+        case 4:
+            return py == ey && px < ex && ex - px <= range &&
+                   span_clear(map_bits_row(bits, ey), pool->occupied_rows[ey], px, ex);
+        default:
+            return false;
+    }
+}
+
+int entity_pool_spot_player(const EntityPool* pool, const MapBits* bits, int px, int py) {
+    if((unsigned)px >= MAP_WIDTH || (unsigned)py >= MAP_HEIGHT) return ENTITY_NONE;
+
+    // Nobody watching on this row or column: one word test each
+    if(pool->watch_rows[py] == 0 && pool->watch_cols[px] == 0) return ENTITY_NONE;
+
+    for(int i = 0; i < pool->count; i++) {
+        if(pool->x[i] != px && pool->y[i] != py) continue;
+        if(entity_pool_can_see(pool, bits, i, px, py)) return i;
+    }
+    return ENTITY_NONE;
+}
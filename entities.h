@@ -0,0 +1,78 @@
+// entities.h - Fixed capacity pool of overworld NPCs and trainers
+#ifndef ENTITIES_H
+#define ENTITIES_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "maps.h"
+#include "map_bits.h"
+
+#define ENTITY_MAX        32
+#define ENTITY_PATH_MAX   32   // Queued steps per entity
+#define ENTITY_NONE       -1
+
+// Entity flags
+#define ENTITY_FLAG_WATCHING 0x01 // Undefeated trainer scanning for the player
+#define ENTITY_FLAG_MOVING   0x02 // Tweening into (x, y)
+
+// Structure of arrays: per-step loops touch only the fields they need.
+// Entities never move between pools, indices stay valid until the next load.
+typedef struct {
+    uint8_t count;
+    uint8_t x[ENTITY_MAX];
+    uint8_t y[ENTITY_MAX];
+    uint8_t direction[ENTITY_MAX];   // 1: up, 2: right, 3: down, 4: left
+    uint8_t flags[ENTITY_MAX];
+    uint8_t vision[ENTITY_MAX];
+    uint8_t party[ENTITY_MAX];
+    uint8_t script[ENTITY_MAX];
+    uint8_t defeat_flag[ENTITY_MAX];
+    uint8_t step_phase[ENTITY_MAX];  // Logic steps left in the current tile step
+    uint8_t blocked_ticks[ENTITY_MAX];
+    uint8_t path_len[ENTITY_MAX];
+    uint8_t path_pos[ENTITY_MAX];
+    uint8_t path[ENTITY_MAX][ENTITY_PATH_MAX / 4]; // Directions, 2 bits each
+    // Cells taken by entities (a moving entity holds both its cells)
+    uint32_t occupied_rows[MAP_HEIGHT];
+    uint32_t occupied_cols[MAP_WIDTH];
+    // Cells of watching trainers, so a player step only checks its row and column
+    uint32_t watch_rows[MAP_HEIGHT];
+    uint32_t watch_cols[MAP_WIDTH];
+} EntityPool;
+
+void entity_pool_clear(EntityPool* pool);
+
+// Add an entity from map data, returns its index or ENTITY_NONE if full
+int entity_pool_add(EntityPool* pool, const NpcSpawn* spawn, bool defeated);
+
+// Entity standing on (or walking into) a cell, ENTITY_NONE if there is none
+int entity_pool_at(const EntityPool* pool, int x, int y);
+
+static inline bool entity_pool_occupied(const EntityPool* pool, int x, int y) {
+    if((unsigned)x >= MAP_WIDTH || (unsigned)y >= MAP_HEIGHT) return false;
+    return (pool->occupied_rows[y] >> x) & 1;
+}
+
+// Replace an entity's queued steps, longer paths are cut at ENTITY_PATH_MAX
+void entity_pool_set_path(EntityPool* pool, int index, const uint8_t* directions, int length);
+
+// True when the entity has no step in progress or queued
+bool entity_pool_is_idle(const EntityPool* pool, int index);
+
+// Stop a trainer from watching, e.g. once it has been spotted or beaten
+void entity_pool_stop_watching(EntityPool* pool, int index);
+
+// Advance every entity by one logic step. Entities never walk into the
+// player's tile or each other; a blocked entity waits and gives up its
+// path after a while. Indices of entities that finished a tile step are
+// written to arrived, the return value is how many.
+int entity_pool_update(EntityPool* pool, const MapBits* bits, int player_x, int player_y, int walk_steps, uint8_t* arrived);
+
+// True if the entity is a watching trainer with a clear view of (px, py)
+bool entity_pool_can_see(const EntityPool* pool, const MapBits* bits, int index, int px, int py);
+
+// Trainer that sees the player at (px, py), only entities on the player's
+// row or column are looked at. ENTITY_NONE if nobody does.
+int entity_pool_spot_player(const EntityPool* pool, const MapBits* bits, int px, int py);
+
+#endif // ENTITIES_H
@@ -1,13 +1,35 @@
 #include "furi.h"
 #include "gui/gui.h"
 #include "input/input.h"
-#include "flipper_mon_icons.h"
-#include <gui/icon_i.h>
 #include <stdlib.h> // Required for rand()
+#include <string.h>
 #include "tiles.h"
-#include "sprites.h"
+#include "assets.h"
 #include "maps.h"
 #include "pokemon.h"
+#include "battle.h"
+#include "text.h"
+#include "bg_cache.h"
+#include "layer_cache.h"
+#include "input_ring.h"
+#include "map_bits.h"
+#include "encounters.h"
+#include "script_vm.h"
+#include "entities.h"
+#include "pathfind.h"
+#include "arena.h"
+#include "profile.h"
+#include "stack_watermark.h"
+#include "bench.h"
+#include "framecheck.h"
+#include "sprite_cache.h"
+#include "boot_profile.h"
+#include "scheduler.h"
+#include "sequencer.h"
+#include "song_data.h"
+#include "link.h"
+#include <storage/storage.h>
+#include <furi_hal.h>
 
 #define TILE_SIZE     16          // New tile size: 16x16 pixels
 #define SCREEN_WIDTH  128
@@ -16,15 +38,43 @@
 #define HP_BAR_HEIGHT 6
 #define BATTLE_BORDER_OFFSET 5
 
+#define LOGIC_HZ      30          // Fixed logic steps per second
+#define TICK_US       (1000000 / LOGIC_HZ)
+#define BACKGROUND_MARGIN_US 3000 // Slack per tick left to the GUI and system threads
+
+// Walking rate is LOGIC_HZ / WALK_STEPS tiles per second
+#ifndef WALK_STEPS
+#define WALK_STEPS    8           // Logic steps to walk across one tile
+#endif
+#define WALK_SPEED    (TILE_SIZE / WALK_STEPS) // Pixels moved per logic step
+_Static_assert(TILE_SIZE % WALK_STEPS == 0, "WALK_STEPS must divide TILE_SIZE");
+
+// How long a direction must be held before the trainer walks, a shorter tap only turns.
+// 0 walks on the press itself.
+#ifndef WALK_FIRST_STEP_DELAY_MS
+#define WALK_FIRST_STEP_DELAY_MS 0
+#endif
+#define BATTLE_ANIM_MIN_TICKS (2 * LOGIC_HZ)   // Attack animation must play this long before OK skips it
+#define BATTLE_ANIM_FRAME_TICKS (LOGIC_HZ / 2) // Logic steps per attack animation frame
+#define SCRIPT_INSTRUCTIONS_PER_TICK 32 // Bytecode budget so a script can never stall rendering
+
 
 // Struct for a Map
 typedef struct {
     const char* name;
     int width;
     int height;
-    Tile tiles[MAP_WIDTH][MAP_HEIGHT];
+    bool loaded; // Tiles have been built
+    uint8_t tiles[MAP_HEIGHT][MAP_WIDTH]; // TileId per cell, row-major
+    uint8_t encounter_zone;               // EncounterZoneId of the map's grass tiles
+    MapBits bits; // Solidity and encounter zones packed from tiles
 } GameMap;
 
+// Tile IDs from (x, y) to the end of row y, contiguous in memory
+static inline const uint8_t* map_row(const GameMap* map, int x, int y) {
+    return &map->tiles[y][x];
+}
+
 // Array of all maps
 static GameMap maps[MAX_MAPS];
 // Index of current active map
@@ -37,15 +87,109 @@ typedef enum {
     SceneBattle,
     SceneWildBattle,
     SceneCutscene,
+    SceneCount,
 } GameScene;
 
+static const char* const scene_names[SceneCount] = {"Exploration", "Battle", "WildBattle", "Cutscene"};
+
+// Transient buffers come from one arena: map data sits at the bottom until
+// the next map transition, scene buffers above map_mark are dropped on
+// every scene switch. Map scripts are kept apart, see SCRIPT_CACHE_SIZE.
+#ifndef SCENE_ARENA_SIZE
+#define SCENE_ARENA_SIZE (16 * 1024)
+#endif
+
 // Scene Manager
 typedef struct {
     GameScene current_scene;
+    Arena arena;
+    size_t map_mark;               // Arena cursor after the current map's data
+    size_t peak[SceneCount];       // Arena high water per scene, for sizing SCENE_ARENA_SIZE
 } SceneManager;
 
 static SceneManager scene_manager = {.current_scene = SceneExploration};
 
+#ifdef FURI_DEBUG
+// Peak stack per scene and path, logged on exit to size stack_size in application.fam
+typedef enum {
+    StackPathInput, // handle_movement, game thread
+    StackPathLogic, // update_game_state, game thread
+    StackPathDraw,  // draw callback, GUI thread
+    StackPathCount
+} StackPath;
+
+static StackProbe stack_probes[SceneCount][StackPathCount];
+
+// Deepest use so far per scene and path, logged whenever a battle ends
+static void stack_probes_log(void) {
+    static const char* const path_names[StackPathCount] = {"input", "logic", "draw"};
+    char probe_name[24];
+    for(int scene = 0; scene < SceneCount; scene++) {
+        for(int path = 0; path < StackPathCount; path++) {
+            snprintf(probe_name, sizeof(probe_name), "%s %s", scene_names[scene], path_names[path]);
+            stack_probe_log(&stack_probes[scene][path], probe_name);
+        }
+    }
+    FURI_LOG_I("Stack", "Game thread minimum free %lu bytes",
+               furi_thread_get_stack_space(furi_thread_get_current_id()));
+}
+#define STACK_PROBES_LOG() stack_probes_log()
+#else
+#define STACK_PROBES_LOG()
+#endif
+
+// Pre-shifted sprites of the current scene, they live in the arena above map_mark
+static SpriteCache sprite_cache;
+// Off until the first frame is up, draws fall back to masked_sprite_draw until then
+static bool scene_sprites_ready;
+_Static_assert(TILE_SIZE == SPRITE_CACHE_SIZE, "Walker sprites are one tile");
+
+// Decoded names of the current battle
+static TextCache text_cache;
+
+// Text for the battle screens, from the cache when it is there. buf needs
+// TEXT_BUFFER_SIZE bytes and is only written on a cache miss.
+static const char* battle_text(uint16_t id, char* buf) {
+    return text_get(&text_cache, id, buf, TEXT_BUFFER_SIZE);
+}
+
+// Every overworld walker sprite, cached while the map is on screen
+static const AssetId overworld_sprites[] = {
+    ASSET_TRAINER_BACKWARD_STANDING, ASSET_TRAINER_BACKWARDS_WALKING_LEFT, ASSET_TRAINER_BACKWARDS_WALKING_RIGHT,
+    ASSET_TRAINER_FORWARD_NORMAL, ASSET_TRAINER_FRONT_WALKING_LEFT, ASSET_TRAINER_FRONT_WALKING_RIGHT,
+    ASSET_TRAINER_LEFT_STANDING, ASSET_TRAINER_LEFT_WALKING, ASSET_TRAINER_RIGHT_STANDING, ASSET_TRAINER_RIGHT_WALKING,
+};
+
+// Drop everything the current scene took from the arena
+static void scene_release(void) {
+    SceneManager* sm = &scene_manager;
+    // Allocation inside a scene only grows, so the cursor is the scene's high water
+    if(sm->arena.used > sm->peak[sm->current_scene]) {
+        sm->peak[sm->current_scene] = sm->arena.used;
+        FURI_LOG_D("Arena", "%s peak %u bytes", scene_names[sm->current_scene], (unsigned)sm->arena.used);
+    }
+    // Forget the cached pointers first, the draw callback must never see
+    // entries into memory that is about to be reused
+    sprite_cache_clear(&sprite_cache);
+    text_cache_clear(&text_cache);
+    arena_release(&sm->arena, sm->map_mark);
+}
+
+// Build the sprite variants a scene draws every frame
+static void load_scene_sprites(GameScene scene) {
+    if(!scene_sprites_ready) return;
+    if(scene != SceneExploration && scene != SceneCutscene) return;
+    for(size_t i = 0; i < COUNT_OF(overworld_sprites); i++) {
+        sprite_cache_load(&sprite_cache, &scene_manager.arena, asset_sprite(overworld_sprites[i]));
+    }
+}
+
+static void scene_switch(GameScene scene) {
+    scene_release();
+    scene_manager.current_scene = scene;
+    load_scene_sprites(scene);
+}
+
 // Define the map dimensions (in tiles).
 #define MAP_WIDTH  20
 #define MAP_HEIGHT 20
@@ -60,12 +204,26 @@ typedef enum {
 typedef struct {
     EventType type;
     InputEvent input;
+    uint32_t tick; // furi_get_tick() when the key event arrived
 } PluginEvent;
 
-static int anim_frame = 0;
+// Key events from the input callback, drained by the game loop
+static InputRing input_ring;
+static bool exit_requested; // Back in the overworld, the game loop ends after this tick
 
 // Player's Pokemon - using the new Pokemon struct from pokemon.h
 static Pokemon player_pokemon;
+static bool player_pokemon_ready; // Created on first use, not at launch
+
+// Startup timeline, logged once the warm-up after the first frame is done
+static BootProfile boot_profile;
+
+// Background work, run in whatever a tick leaves after logic and drawing
+static Scheduler scheduler;
+static volatile uint32_t last_draw_cycles; // Written by the draw callback
+
+// Music and sound effects, played from their own timer
+static Sequencer sequencer;
 
 // Wild Pokemon for battles
 static Pokemon wild_pokemon;
@@ -74,11 +232,76 @@ static Pokemon wild_pokemon;
 typedef struct {
     int x;
     int y;
-    int direction; // 0: up, 1: right, 2: down, 3: left
+    int direction; // 1: up, 2: right, 3: down, 4: left
+    int step_phase; // Logic steps left in the current tile step, 0 when standing
+    int step_dx;
+    int step_dy;
+    int step_count; // Completed tile steps, alternates the walking foot
+    int queued_direction; // Direction pressed during a step, 0 if none
+    int held_direction; // Direction key currently held down, 0 if none
 } Trainer;
 
 static Trainer trainer = { .x = 32, .y = 32, .direction = 2 };
 
+// Repel and post-battle encounter suppression
+static EncounterState encounter_state;
+
+// Steps after a battle before the next wild encounter can happen
+#define ENCOUNTER_GRACE_STEPS 3
+
+// Items in the bag, indices match the names in tools/script_compiler.py
+typedef enum {
+    ItemPotion,
+    ItemPokeBall,
+    ItemRepel,
+    ItemCount
+} ItemId;
+
+static uint8_t bag[ItemCount];
+
+// Compiled scripts of every map loaded so far stay for the whole session,
+// a few hundred bytes per map, so entering a map the prefetch task has
+// already seen never reads the SD card
+#ifndef SCRIPT_CACHE_SIZE
+#define SCRIPT_CACHE_SIZE (2 * 1024)
+#endif
+
+// Cutscene and NPC scripts, the VM runs the current map's program
+static ScriptVm script_vm;
+static Arena script_arena;
+static ScriptProgram map_scripts[MAX_MAPS]; // Empty for maps without scripts
+static bool map_scripts_read[MAX_MAPS];     // Storage was checked for the map
+static bool script_battle_pending = false; // Script is waiting for a battle to end
+static int script_npc_pending = ENTITY_NONE; // NPC a script waits on to finish walking
+
+// NPCs and trainers of the current map
+static EntityPool entities;
+static PathScratch path_scratch;
+static int approaching_trainer = ENTITY_NONE; // Trainer walking up to the player after spotting them
+
+// Trainer battle in progress, NULL for wild battles
+static const TrainerParty* battle_trainer = NULL;
+static int battle_party_index = 0;
+static int battle_trainer_entity = ENTITY_NONE;
+
+// Background pixels from the previous exploration frame
+static BgCache bg_cache;
+
+// Sprites, names and frames of the battle screen, see battle_layer_key
+static LayerCache battle_layer;
+
+// Measured responsiveness of held-key walking
+typedef struct {
+    uint32_t press_tick;        // When the held direction went down
+    bool awaiting_first_step;   // Press seen, trainer has not started walking yet
+    uint32_t last_latency_ms;   // Press to first step of the last walk
+    uint32_t max_latency_ms;
+    uint32_t walk_start_tick;   // First step of the current walk
+    uint32_t walk_steps;        // Tiles walked in the current walk
+} WalkStats;
+
+static WalkStats walk_stats;
+
 
 
 // Battle UI states
@@ -106,34 +329,34 @@ static DialogBox dialog_box = {.is_active = false, .cursor_position = 0, .option
 static int battle_animation_frame = 0;
 static int battle_animation_timer = 0;
 static bool player_turn = true;
-static int selected_move_index = 0;
-static char battle_result_text[64] = "";
-static int damage_dealt = 0;
+static BattleEventQueue battle_events; // Current turn, shown one page per event
+static BattleRng battle_rng;           // Seeded when a battle opens
+
+// Formatted text for the draw code. Draw callbacks never run concurrently,
+// so one buffer keeps the strings off the GUI thread's stack.
+static char draw_text[64];
+static char draw_name[TEXT_BUFFER_SIZE];
+#define LEVEL_TEXT_MAX 16
+#define HP_TEXT_MAX    8
 
-// Helper function to draw health bar
+// Helper function to draw health bar, the border is part of the battle layer
 static void draw_health_bar_opponent(Canvas* canvas, int x, int y, int width, int height, int current_hp, int max_hp) {
     int filled_width = (current_hp * width) / max_hp;
 
-    // Draw border
-    canvas_draw_frame(canvas, x, y, width, height);
-
     // Fill the health bar
     canvas_draw_box(canvas, x + 1, y + 1, filled_width - 2, height - 2);
 
     // Draw HP text next to bar
-    char hp_text[8];
-    snprintf(hp_text, sizeof(hp_text), "%d HP", current_hp);
-    canvas_draw_str(canvas, x + width - width, y + height + 8, hp_text);
+    snprintf(draw_text, HP_TEXT_MAX, "%d HP", current_hp);
+    canvas_draw_str(canvas, x + width - width, y + height + 8, draw_text);
 }
 
-// Helper function to draw health bar
+// Helper function to draw health bar, the border is part of the battle layer
 static void draw_health_bar_player(Canvas* canvas, int x, int y, int width, int height, int current_hp, int max_hp) {
     int filled_width = (current_hp * width) / max_hp;
     // Draw HP text next to bar
-    char hp_text[8];
-    snprintf(hp_text, sizeof(hp_text), "%d HP", current_hp);
-    canvas_draw_str(canvas, x, y + height +10, hp_text);
-    canvas_draw_frame(canvas, x, y + 2, width, height);
+    snprintf(draw_text, HP_TEXT_MAX, "%d HP", current_hp);
+    canvas_draw_str(canvas, x, y + height +10, draw_text);
 
     // Fill the health bar
     canvas_draw_box(canvas, x + 1, y + 3, filled_width - 2, height - 2);
@@ -179,14 +402,14 @@ static void draw_move_menu(Canvas* canvas, int x, int y) {
         int option_y = y + 8 + (i / 2) * 12;
         
         // Skip empty move slots
-        if(player_pokemon.moves[i].name[0] == '\0') continue;
+        if(player_pokemon.moves[i] == NULL) continue;
         
         // Highlight selected move
         if(dialog_box.cursor_position == i) {
             canvas_draw_str(canvas, option_x - 2, option_y, ">");
         }
         
-        canvas_draw_str(canvas, option_x + 5, option_y, player_pokemon.moves[i].name);
+        canvas_draw_str(canvas, option_x + 5, option_y, battle_text(player_pokemon.moves[i]->name, draw_name));
     }
 }
 
@@ -194,12 +417,11 @@ static void draw_move_menu(Canvas* canvas, int x, int y) {
 static void draw_dialog_text(Canvas* canvas, int x, int y, int width, int height) {
     draw_dialog_box(canvas, x, y, width, height);
 
-    char text_copy[64];
-    strncpy(text_copy, dialog_box.text, sizeof(text_copy));
-    text_copy[sizeof(text_copy) - 1] = '\0';
+    strncpy(draw_text, dialog_box.text, sizeof(draw_text));
+    draw_text[sizeof(draw_text) - 1] = '\0';
 
     int line_y = y + 10;
-    char* start = text_copy;
+    char* start = draw_text;
     char* end;
 
     while((end = strchr(start, '\n')) != NULL) {
@@ -217,11 +439,24 @@ static void draw_dialog_text(Canvas* canvas, int x, int y, int width, int height
     }
 }
 
+// "Wild " or "Foe " in front of the opponent's name
+static const char* enemy_prefix(void) {
+    return battle_trainer ? "Foe " : "Wild ";
+}
+
 // Update the battle UI based on current state
 static void update_battle_ui(void) {
+    PROFILE_SCOPE(ProfileBattleUi);
+    char name[TEXT_BUFFER_SIZE];
     switch(battle_state) {
         case BattleStateIntro:
-            snprintf(dialog_box.text, sizeof(dialog_box.text), "A wild %s appeared!", wild_pokemon.name);
+            if(battle_trainer) {
+                char trainer_name[TEXT_BUFFER_SIZE];
+                snprintf(dialog_box.text, sizeof(dialog_box.text), "%s sent\nout %s!",
+                         battle_text(battle_trainer->name, trainer_name), battle_text(wild_pokemon.name, name));
+            } else {
+                snprintf(dialog_box.text, sizeof(dialog_box.text), "A wild %s appeared!", battle_text(wild_pokemon.name, name));
+            }
             dialog_box.is_active = true;
             dialog_box.option_count = 0;
             break;
@@ -237,7 +472,7 @@ static void update_battle_ui(void) {
             // Count how many non-empty moves the player has
             dialog_box.option_count = 0;
             for(int i = 0; i < 4; i++) {
-                if(player_pokemon.moves[i].name[0] != '\0') {
+                if(player_pokemon.moves[i] != NULL) {
                     dialog_box.option_count++;
                 }
             }
@@ -245,100 +480,180 @@ static void update_battle_ui(void) {
             break;
             
         case BattleStateExecuteMove:
-            snprintf(dialog_box.text, sizeof(dialog_box.text), "%s used %s!", 
-                     player_pokemon.name, player_pokemon.moves[selected_move_index].name);
-            dialog_box.is_active = true;
-            dialog_box.option_count = 0;
-            battle_animation_frame = 0;
-            battle_animation_timer = 0;
-            break;
-            
+        case BattleStateEnemyTurn:
         case BattleStateResult:
-            snprintf(dialog_box.text, sizeof(dialog_box.text), "%s", battle_result_text);
-            dialog_box.is_active = true;
-            dialog_box.option_count = 0;
+            // Pages of the turn's events, see show_next_battle_event
             break;
             
-        case BattleStateEnemyTurn:
-            // Randomly select a move for the wild Pokemon
-            int valid_moves = 0;
-            for(int i = 0; i < 4; i++) {
-                if(wild_pokemon.moves[i].name[0] != '\0') {
-                    valid_moves++;
-                }
-            }
-            
-            if(valid_moves == 0) {
-                // If no valid moves (shouldn't happen), go back to player turn
-                battle_state = BattleStateChooseAction;
-                player_turn = true;
-                break;
-            }
-            
-            // Select a random valid move
-            int enemy_move_index = rand() % valid_moves;
-            int actual_index = 0;
-            for(int i = 0; i < 4; i++) {
-                if(wild_pokemon.moves[i].name[0] != '\0') {
-                    if(actual_index == enemy_move_index) {
-                        enemy_move_index = i;
-                        break;
-                    }
-                    actual_index++;
-                }
+        case BattleStateEnd:
+            // Only trainer battles end on a page of their own
+            if(battle_trainer) {
+                snprintf(dialog_box.text, sizeof(dialog_box.text), "%s\nwas defeated!", battle_text(battle_trainer->name, name));
             }
-            
-            // Execute the enemy move
-            snprintf(dialog_box.text, sizeof(dialog_box.text), "Wild %s used %s!", 
-                     wild_pokemon.name, wild_pokemon.moves[enemy_move_index].name);
             dialog_box.is_active = true;
             dialog_box.option_count = 0;
-            
-            // Calculate damage to player
-            damage_dealt = calculate_damage(wild_pokemon.moves[enemy_move_index], wild_pokemon, player_pokemon);
-            player_pokemon.current_hp -= damage_dealt;
-            if(player_pokemon.current_hp < 0) player_pokemon.current_hp = 0;
-            
+            break;
+    }
+}
+
+// Decode the names the battle screens show on every page and frame
+static void load_battle_text(void) {
+    const Pokemon* sides[2] = {&player_pokemon, &wild_pokemon};
+    for(int i = 0; i < 2; i++) {
+        text_cache_load(&text_cache, sides[i]->name);
+        for(int j = 0; j < 4; j++) {
+            if(sides[i]->moves[j]) text_cache_load(&text_cache, sides[i]->moves[j]->name);
+        }
+    }
+    if(battle_trainer) text_cache_load(&text_cache, battle_trainer->name);
+}
+
+static const Pokemon* battle_side_pokemon(uint8_t side) {
+    return side == BattleSidePlayer ? &player_pokemon : &wild_pokemon;
+}
+
+static const uint16_t status_text[EFFECT_COUNT] = {
+    [EFFECT_BURN] = TEXT_BURNED,
+    [EFFECT_PARALYZE] = TEXT_PARALYZED,
+    [EFFECT_SLEEP] = TEXT_ASLEEP,
+    [EFFECT_POISON] = TEXT_POISONED,
+};
+
+// Why a status kept a Pokemon from moving, and how it hurts one
+static const uint16_t status_skip_text[EFFECT_COUNT] = {
+    [EFFECT_PARALYZE] = TEXT_FULLY_PARALYZED,
+    [EFFECT_SLEEP] = TEXT_FAST_ASLEEP,
+};
+
+static const uint16_t status_hurt_text[EFFECT_COUNT] = {
+    [EFFECT_BURN] = TEXT_HURT_BY_BURN,
+    [EFFECT_POISON] = TEXT_HURT_BY_POISON,
+};
+
+// Show the next event of the turn as a dialog page, false once the turn has
+// been shown. Text is only formatted for pages that are actually shown.
+static bool show_next_battle_event(void) {
+    const BattleEvent* event = battle_events_next(&battle_events);
+    if(event == NULL) return false;
+
+    const Pokemon* pokemon = battle_side_pokemon(event->side);
+    const char* prefix = event->side == BattleSidePlayer ? "" : enemy_prefix();
+    char name_buf[TEXT_BUFFER_SIZE];
+    char text_buf[TEXT_BUFFER_SIZE];
+    const char* name = battle_text(pokemon->name, name_buf);
+    battle_state = BattleStateResult;
+
+    switch(event->type) {
+        case BattleEventMoveUsed:
+            snprintf(dialog_box.text, sizeof(dialog_box.text), "%s%s used %s!",
+                     prefix, name, battle_text(pokemon->moves[event->value]->name, text_buf));
+            battle_state = event->side == BattleSidePlayer ? BattleStateExecuteMove : BattleStateEnemyTurn;
             battle_animation_frame = 0;
             battle_animation_timer = 0;
             break;
-            
-        case BattleStateEnd:
-            if(wild_pokemon.current_hp <= 0) {
-                snprintf(dialog_box.text, sizeof(dialog_box.text), "Wild %s fainted!", wild_pokemon.name);
-            } else if(player_pokemon.current_hp <= 0) {
-                snprintf(dialog_box.text, sizeof(dialog_box.text), "%s fainted!", player_pokemon.name);
-            }
-            dialog_box.is_active = true;
-            dialog_box.option_count = 0;
+        case BattleEventMiss:
+            snprintf(dialog_box.text, sizeof(dialog_box.text), "%s%s's\nattack missed!", prefix, name);
+            break;
+        case BattleEventDamage:
+            snprintf(dialog_box.text, sizeof(dialog_box.text), "It did %d damage!", event->value);
+            sequencer_play_sfx(&sequencer, &songs[SONG_HIT]);
+            break;
+        case BattleEventNoEffect:
+            text_decode(TEXT_NO_EFFECT, dialog_box.text, sizeof(dialog_box.text));
+            break;
+        case BattleEventStatus:
+            snprintf(dialog_box.text, sizeof(dialog_box.text), "%s%s\n%s", prefix, name, battle_text(status_text[event->value], text_buf));
+            break;
+        case BattleEventCantMove:
+            snprintf(dialog_box.text, sizeof(dialog_box.text), "%s%s\n%s", prefix, name, battle_text(status_skip_text[event->value], text_buf));
+            break;
+        case BattleEventWokeUp:
+            snprintf(dialog_box.text, sizeof(dialog_box.text), "%s%s\n%s", prefix, name, battle_text(TEXT_WOKE_UP, text_buf));
+            break;
+        case BattleEventHurt:
+            snprintf(dialog_box.text, sizeof(dialog_box.text), "%s%s\n%s", prefix, name, battle_text(status_hurt_text[pokemon->status], text_buf));
+            sequencer_play_sfx(&sequencer, &songs[SONG_HIT]);
+            break;
+        case BattleEventFaint:
+            snprintf(dialog_box.text, sizeof(dialog_box.text), "%s%s fainted!", prefix, name);
             break;
     }
+
+    dialog_box.is_active = true;
+    dialog_box.option_count = 0;
+    return true;
 }
 
 // Execute a player's move
 void execute_player_move(int move_index) {
-    selected_move_index = move_index;
-    
-    // Calculate damage
-    Move selected_move = player_pokemon.moves[move_index];
-    damage_dealt = calculate_damage(selected_move, player_pokemon, wild_pokemon);
-    
-    // Apply damage to wild Pokemon
-    wild_pokemon.current_hp -= damage_dealt;
-    if(wild_pokemon.current_hp < 0) wild_pokemon.current_hp = 0;
-    
-    // Set result text
-    if(damage_dealt > 0) {
-        snprintf(battle_result_text, sizeof(battle_result_text), "It did %d damage!", damage_dealt);
+    if(player_pokemon.moves[move_index] == NULL) return;
+    battle_events_clear(&battle_events);
+    battle_resolve_move(&battle_events, &battle_rng, BattleSidePlayer, &player_pokemon, &wild_pokemon, move_index);
+    show_next_battle_event();
+}
+
+// Resolve the opponent's move and show its first page
+static void start_enemy_turn(void) {
+    player_turn = false;
+    // Trainers pick their best move, wild Pokemon attack at random
+    int slot = battle_trainer ? battle_pick_best_move(&wild_pokemon, &player_pokemon) : battle_pick_move(&wild_pokemon);
+    if(slot < 0) {
+        // If no valid moves (shouldn't happen), go back to player turn
+        battle_state = BattleStateChooseAction;
+        player_turn = true;
+        update_battle_ui();
+        return;
+    }
+    battle_events_clear(&battle_events);
+    battle_resolve_move(&battle_events, &battle_rng, BattleSideOpponent, &wild_pokemon, &player_pokemon, slot);
+    show_next_battle_event();
+}
+
+// Back to the overworld and its music, however the battle ended
+static void leave_battle(void) {
+    pokemon_clear_status(&player_pokemon);
+    scene_switch(SceneExploration);
+    sequencer_play_music(&sequencer, &songs[SONG_OVERWORLD]);
+    STACK_PROBES_LOG();
+}
+
+// Leave the battle scene
+static void end_battle(void) {
+    // Beaten trainers stay beaten, the flag is part of the script state
+    if(battle_trainer && wild_pokemon.current_hp <= 0 && battle_trainer_entity != ENTITY_NONE) {
+        script_vm_set_flag(&script_vm, entities.defeat_flag[battle_trainer_entity], true);
+    }
+    leave_battle();
+}
+
+// Next page of the turn, or whatever follows once all of it was shown
+static void advance_battle(void) {
+    if(show_next_battle_event()) return;
+
+    if(wild_pokemon.current_hp <= 0 && player_pokemon.current_hp > 0 && battle_trainer &&
+       battle_party_index + 1 < battle_trainer->count) {
+        // A trainer with Pokemon left sends out the next one
+        battle_party_index++;
+        create_pokemon(&wild_pokemon, battle_trainer->species[battle_party_index], battle_trainer->levels[battle_party_index]);
+        load_battle_text();
+        battle_state = BattleStateIntro;
+        player_turn = true;
+        update_battle_ui();
+    } else if(wild_pokemon.current_hp <= 0 && battle_trainer) {
+        battle_state = BattleStateEnd;
+        update_battle_ui();
+    } else if(wild_pokemon.current_hp <= 0 || player_pokemon.current_hp <= 0) {
+        // The faint page was the last word
+        end_battle();
+    } else if(player_turn) {
+        start_enemy_turn();
     } else {
-        snprintf(battle_result_text, sizeof(battle_result_text), "It had no effect...");
+        battle_state = BattleStateChooseAction;
+        player_turn = true;
+        update_battle_ui();
     }
-    
-    battle_state = BattleStateExecuteMove;
-    update_battle_ui();
 }
 
-// Process battle input
 static void process_battle_input(InputKey key) {
     switch(battle_state) {
         case BattleStateIntro:
@@ -369,13 +684,13 @@ static void process_battle_input(InputKey key) {
                         // Fight option selected
                         battle_state = BattleStateChooseMove;
                         update_battle_ui();
-                    } else if(dialog_box.cursor_position == 3) {
-                        // Run option selected
-                        scene_manager.current_scene = SceneExploration;
+                    } else if(dialog_box.cursor_position == 3 && !battle_trainer) {
+                        // Run option selected, there is no running from trainers
+                        leave_battle();
                     }
                     break;
                 case InputKeyBack:
-                    scene_manager.current_scene = SceneExploration;
+                    if(!battle_trainer) leave_battle();
                     break;
                 default:
                     break;
@@ -411,46 +726,21 @@ static void process_battle_input(InputKey key) {
             break;
             
         case BattleStateExecuteMove:
-            if(key == InputKeyOk && battle_animation_timer > 20) {
-                battle_state = BattleStateResult;
-                update_battle_ui();
+        case BattleStateEnemyTurn:
+            if(key == InputKeyOk && battle_animation_timer > BATTLE_ANIM_MIN_TICKS) {
+                advance_battle();
             }
             break;
             
         case BattleStateResult:
             if(key == InputKeyOk) {
-                // First, check if the battle has ended
-                if(wild_pokemon.current_hp <= 0 || player_pokemon.current_hp <= 0) {
-                    battle_state = BattleStateEnd;
-                    update_battle_ui();
-                } else {
-                    // If the battle is not over, check whose turn just ended
-                    if(player_turn) {
-                        // It was the player's turn, so now it's the enemy's turn
-                        battle_state = BattleStateEnemyTurn;
-                        player_turn = false;
-                        update_battle_ui();
-                    } else {
-                        // It was the enemy's turn, so now it's the player's turn again
-                        battle_state = BattleStateChooseAction;
-                        player_turn = true;
-                        update_battle_ui();
-                    }
-                }
-            }
-            break;
-            
-        case BattleStateEnemyTurn:
-            if(key == InputKeyOk && battle_animation_timer > 20) {
-                snprintf(battle_result_text, sizeof(battle_result_text), "It did %d damage!", damage_dealt);
-                battle_state = BattleStateResult;
-                update_battle_ui();
+                advance_battle();
             }
             break;
             
         case BattleStateEnd:
             if(key == InputKeyOk) {
-                scene_manager.current_scene = SceneExploration;
+                end_battle();
             }
             break;
     }
@@ -460,7 +750,7 @@ static void process_battle_input(InputKey key) {
 static void update_battle_animation(void) {
     battle_animation_timer++;
     
-    if(battle_animation_timer % 5 == 0) {
+    if(battle_animation_timer % BATTLE_ANIM_FRAME_TICKS == 0) {
         battle_animation_frame++;
     }
 }
@@ -472,40 +762,52 @@ void handle_battle_input(PluginEvent* event) {
     }
 }
 
-// Update the draw_battle_scene function to include our new UI elements
-static void draw_battle_scene(Canvas* canvas) {
-    canvas_clear(canvas);
+// Battle screen layout
+#define BATTLE_OPPONENT_X    (SCREEN_WIDTH - 60)
+#define BATTLE_OPPONENT_Y    0
+#define BATTLE_OPP_INFO_X    5
+#define BATTLE_OPP_INFO_Y    5
+#define BATTLE_PLAYER_X      20
+#define BATTLE_PLAYER_Y      (SCREEN_HEIGHT - 40)
+#define BATTLE_PLAYER_INFO_X (SCREEN_WIDTH - 70)
+#define BATTLE_PLAYER_INFO_Y (SCREEN_HEIGHT - 25)
+
+// Everything the static battle layer shows: both Pokemon and whether this
+// is a trainer battle. Species and levels are below 256 and 128.
+static uint32_t battle_layer_key(void) {
+    return (uint32_t)wild_pokemon.species | (uint32_t)wild_pokemon.level << 8 |
+           (uint32_t)player_pokemon.species << 16 | (uint32_t)(player_pokemon.level & 0x7F) << 24 |
+           (uint32_t)(battle_trainer != NULL) << 31;
+}
 
-    // Draw background
+// The parts of the battle screen that only change with a new Pokemon
+static void draw_battle_layer(Canvas* canvas, void* ctx) {
+    (void)ctx;
+
+    // Opponent sprite, name and HP bar border
+    masked_sprite_draw(canvas, wild_pokemon.front_sprite, BATTLE_OPPONENT_X, BATTLE_OPPONENT_Y);
+    snprintf(draw_text, LEVEL_TEXT_MAX, "%s%s LV%d", battle_trainer ? "" : "Wild ", battle_text(wild_pokemon.name, draw_name), wild_pokemon.level);
+    canvas_draw_str(canvas, BATTLE_OPP_INFO_X, BATTLE_OPP_INFO_Y, draw_text);
+    canvas_draw_frame(canvas, BATTLE_OPP_INFO_X, BATTLE_OPP_INFO_Y + 5, HP_BAR_WIDTH, HP_BAR_HEIGHT);
+
+    // Player sprite, name and HP bar border
+    masked_sprite_draw(canvas, player_pokemon.back_sprite, BATTLE_PLAYER_X, BATTLE_PLAYER_Y);
+    snprintf(draw_text, LEVEL_TEXT_MAX, "%s LV%d", battle_text(player_pokemon.name, draw_name), player_pokemon.level);
+    canvas_draw_str(canvas, BATTLE_PLAYER_INFO_X, BATTLE_PLAYER_INFO_Y, draw_text);
+    canvas_draw_frame(canvas, BATTLE_PLAYER_INFO_X, BATTLE_PLAYER_INFO_Y + 7, HP_BAR_WIDTH, HP_BAR_HEIGHT);
+}
+
+// Static layer from the cache, then HP, menus, dialog and effects on top
+static void draw_battle_scene(Canvas* canvas) {
+    PROFILE_SCOPE(ProfileDrawBattle);
+    layer_cache_draw(&battle_layer, canvas, battle_layer_key(), draw_battle_layer, NULL);
     canvas_set_color(canvas, ColorBlack);
-    
-    // Draw opponent Pokemon
-    int opponent_x = SCREEN_WIDTH - 60;
-    int opponent_y = 0;
-    canvas_draw_xbm(canvas, opponent_x, opponent_y, 42, 42, wild_pokemon.front_sprite);
-    
-    // Draw opponent info
-    int opp_hp_x = 5, opp_hp_y = 5;
-    char opp_level_text[16];
-    snprintf(opp_level_text, sizeof(opp_level_text), "Wild %s LV%d", wild_pokemon.name, wild_pokemon.level);
-    canvas_draw_str(canvas, opp_hp_x, opp_hp_y, opp_level_text);
-    draw_health_bar_opponent(canvas, opp_hp_x, opp_hp_y + 5, HP_BAR_WIDTH, HP_BAR_HEIGHT, 
-                          wild_pokemon.current_hp, wild_pokemon.max_hp);
-    
-    // Draw player Pokemon
-    int player_x = 20;
-    int player_y = SCREEN_HEIGHT - 40;
-    canvas_draw_xbm(canvas, player_x, player_y, 42, 42, player_pokemon.back_sprite);
-    
-    // Draw player info
-    int player_hp_x = SCREEN_WIDTH - 70;
-    int player_hp_y = SCREEN_HEIGHT - 25;
-    char player_level_text[16];
-    snprintf(player_level_text, sizeof(player_level_text), "%s LV%d", player_pokemon.name, player_pokemon.level);
-    canvas_draw_str(canvas, player_hp_x, player_hp_y, player_level_text);
-    draw_health_bar_player(canvas, player_hp_x, player_hp_y + 5, HP_BAR_WIDTH, HP_BAR_HEIGHT, 
-                        player_pokemon.current_hp, player_pokemon.max_hp);
-    
+
+    draw_health_bar_opponent(canvas, BATTLE_OPP_INFO_X, BATTLE_OPP_INFO_Y + 5, HP_BAR_WIDTH, HP_BAR_HEIGHT,
+                             wild_pokemon.current_hp, wild_pokemon.max_hp);
+    draw_health_bar_player(canvas, BATTLE_PLAYER_INFO_X, BATTLE_PLAYER_INFO_Y + 5, HP_BAR_WIDTH, HP_BAR_HEIGHT,
+                           player_pokemon.current_hp, player_pokemon.max_hp);
+
     // Draw UI based on battle state
     switch(battle_state) {
         case BattleStateIntro:
@@ -529,13 +831,13 @@ static void draw_battle_scene(Canvas* canvas) {
     if(battle_state == BattleStateExecuteMove && battle_animation_frame < 3) {
         // Simple shake animation for player attack
         int shake_offset = (battle_animation_frame % 2 == 0) ? 2 : -2;
-        canvas_draw_line(canvas, opponent_x + shake_offset, 0, opponent_x + 42 + shake_offset, 42);
+        canvas_draw_line(canvas, BATTLE_OPPONENT_X + shake_offset, 0, BATTLE_OPPONENT_X + 42 + shake_offset, 42);
     }
     
     if(battle_state == BattleStateEnemyTurn && battle_animation_frame < 3) {
         // Simple shake animation for enemy attack
         int shake_offset = (battle_animation_frame % 2 == 0) ? 2 : -2;
-        canvas_draw_line(canvas, player_x + shake_offset, player_y, player_x + 42 + shake_offset, player_y + 42);
+        canvas_draw_line(canvas, BATTLE_PLAYER_X + shake_offset, BATTLE_PLAYER_Y, BATTLE_PLAYER_X + 42 + shake_offset, BATTLE_PLAYER_Y + 42);
     }
 }
 
@@ -558,142 +860,844 @@ static inline int full_map_height_pixels(void) {
 
 // ---------------- SCENES ---------------- //
 
-// **Exploration Scene**
-static void draw_exploration_scene(Canvas* canvas) {
-    canvas_clear(canvas);
-    int camera_x = trainer.x - SCREEN_WIDTH / 2;
-    int camera_y = trainer.y - SCREEN_HEIGHT / 2;
-    camera_x = clamp(camera_x, 0, full_map_width_pixels() - SCREEN_WIDTH);
-    camera_y = clamp(camera_y, 0, full_map_height_pixels() - SCREEN_HEIGHT);
-
-    int start_tile_x = camera_x / TILE_SIZE;
-    int start_tile_y = camera_y / TILE_SIZE;
-    int end_tile_x = (camera_x + SCREEN_WIDTH - 1) / TILE_SIZE;
-    int end_tile_y = (camera_y + SCREEN_HEIGHT - 1) / TILE_SIZE;
+// Draw the map tiles covering a screen rectangle (called by the background cache)
+static void draw_map_tiles(Canvas* canvas, int camera_x, int camera_y, int x, int y, int w, int h, void* ctx) {
+    (void)ctx;
+    int start_tile_x = (camera_x + x) / TILE_SIZE;
+    int start_tile_y = (camera_y + y) / TILE_SIZE;
+    int end_tile_x = (camera_x + x + w - 1) / TILE_SIZE;
+    int end_tile_y = (camera_y + y + h - 1) / TILE_SIZE;
 
     for(int ty = start_tile_y; ty <= end_tile_y; ty++) {
+        const uint8_t* row = map_row(CURRENT_MAP, start_tile_x, ty);
+        int py = ty * TILE_SIZE - camera_y;
+
         for(int tx = start_tile_x; tx <= end_tile_x; tx++) {
-            Tile tile = CURRENT_MAP->tiles[tx][ty];
             int px = tx * TILE_SIZE - camera_x;
-            int py = ty * TILE_SIZE - camera_y;
+            masked_sprite_draw(canvas, asset_sprite(tile_defs[*row++].sprite), px, py);
 
-            // Grass
-            if (tile.is_obstacle && (tile.y == 0 || tile.y ==  20))
-                canvas_draw_xbm(canvas, px, py, TILE_SIZE, TILE_SIZE, fence_top_bottom);
-            else
-                canvas_draw_xbm(canvas, px, py, TILE_SIZE, TILE_SIZE, grass);
-
-            if (tile.transition_map_index != -1) {
+            if (map_find_exit(current_map_index, tx, ty) != NULL) {
                 canvas_draw_box(canvas, px, py, TILE_SIZE, TILE_SIZE);
             }
         }
     }
+}
+
+// Walk cycle frame for the current point of a tile step: 0 standing, 1 left foot, 2 right foot.
+// The foot is down for the first half of the step and alternates every tile.
+static int trainer_walk_frame(void) {
+    if(trainer.step_phase <= WALK_STEPS / 2) return 0;
+    return (trainer.step_count % 2 == 0) ? 1 : 2;
+}
+
+// Overworld sprite for a direction (1: up .. 4: left) and walk cycle frame
+static const MaskedSprite* walker_sprite(int direction, int frame) {
+    switch(direction) {
+        case 1: return asset_sprite((frame == 0) ? ASSET_TRAINER_BACKWARD_STANDING : (frame == 1) ? ASSET_TRAINER_BACKWARDS_WALKING_LEFT : ASSET_TRAINER_BACKWARDS_WALKING_RIGHT);
+        case 2: return asset_sprite((frame == 0) ? ASSET_TRAINER_RIGHT_STANDING : ASSET_TRAINER_RIGHT_WALKING);
+        case 3: return asset_sprite((frame == 0) ? ASSET_TRAINER_FORWARD_NORMAL : (frame == 1) ? ASSET_TRAINER_FRONT_WALKING_LEFT : ASSET_TRAINER_FRONT_WALKING_RIGHT);
+        case 4: return asset_sprite((frame == 0) ? ASSET_TRAINER_LEFT_STANDING : ASSET_TRAINER_LEFT_WALKING);
+        default: return asset_sprite(ASSET_TRAINER_FORWARD_NORMAL);
+    }
+}
+
+// Draw the NPCs that overlap the screen, mid-step ones at their tweened position
+static void draw_npcs(Canvas* canvas, int camera_x, int camera_y) {
+    static const int dir_dx[5] = {0, 0, 1, 0, -1};
+    static const int dir_dy[5] = {0, -1, 0, 1, 0};
+
+    for(int i = 0; i < entities.count; i++) {
+        int dir = entities.direction[i];
+        int phase = (entities.flags[i] & ENTITY_FLAG_MOVING) ? entities.step_phase[i] : 0;
+        int x = entities.x[i] * TILE_SIZE - dir_dx[dir] * phase * WALK_SPEED - camera_x;
+        int y = entities.y[i] * TILE_SIZE - dir_dy[dir] * phase * WALK_SPEED - camera_y;
+        if(x <= -TILE_SIZE || x >= SCREEN_WIDTH || y <= -TILE_SIZE || y >= SCREEN_HEIGHT) continue;
+
+        int frame = phase > WALK_STEPS / 2 ? 1 + (entities.x[i] + entities.y[i]) % 2 : 0;
+        sprite_cache_draw(&sprite_cache, canvas, walker_sprite(dir, frame), x, y);
+
+        if(i == approaching_trainer) {
+            canvas_draw_str(canvas, x + TILE_SIZE / 2 - 1, y - 1, "!");
+        }
+    }
+}
+
+// **Exploration Scene**
+static void draw_exploration_scene(Canvas* canvas) {
+    PROFILE_SCOPE(ProfileDrawExploration);
+    // The camera follows the trainer at pixel precision while a step is tweened
+    int camera_x = trainer.x - SCREEN_WIDTH / 2;
+    int camera_y = trainer.y - SCREEN_HEIGHT / 2;
+    camera_x = clamp(camera_x, 0, full_map_width_pixels() - SCREEN_WIDTH);
+    camera_y = clamp(camera_y, 0, full_map_height_pixels() - SCREEN_HEIGHT);
+
+    bg_cache_draw(&bg_cache, canvas, current_map_index, camera_x, camera_y, draw_map_tiles, NULL);
 
     int trainer_x = clamp(trainer.x, 0, full_map_width_pixels() - TILE_SIZE);
     int trainer_y = clamp(trainer.y, 0, full_map_height_pixels() - TILE_SIZE);
     int draw_x = trainer_x - camera_x;
     int draw_y = trainer_y - camera_y;
 
-    const unsigned char* sprite = trainer_forward_normal;
-    switch(trainer.direction) {
-        case 1: sprite = (anim_frame % 3 == 0) ? trainer_backward_standing : (anim_frame % 3 == 1) ? trainer_backwards_walking_left : trainer_backwards_walking_right; break;
-        case 2: sprite = (anim_frame % 2 == 0) ? trainer_right_standing : trainer_right_walking; break;
-        case 3: sprite = (anim_frame % 3 == 0) ? trainer_forward_normal : (anim_frame % 3 == 1) ? trainer_front_walking_left : trainer_front_walking_right; break;
-        case 4: sprite = (anim_frame % 2 == 0) ? trainer_left_standing : trainer_left_walking; break;
-    }
-    canvas_draw_xbm(canvas, draw_x, draw_y, TILE_SIZE, TILE_SIZE, sprite);
+    draw_npcs(canvas, camera_x, camera_y);
+
+    sprite_cache_draw(&sprite_cache, canvas, walker_sprite(trainer.direction, trainer_walk_frame()), draw_x, draw_y);
 }
 
-// Start a battle with a wild Pokemon
-void start_battle(PokemonSpecies species, int level) {
+// Give the player a starter the first time one is needed
+static void ensure_player_pokemon(void) {
+    if(player_pokemon_ready) return;
+    // Starting with Bulbasaur level 5
+    create_pokemon(&player_pokemon, POKEMON_BULBASAUR, 5);
+    player_pokemon_ready = true;
+}
+
+// Set up the battle scene against a freshly created opponent
+static void open_battle(PokemonSpecies species, int level) {
+    char name[TEXT_BUFFER_SIZE];
+    ensure_player_pokemon();
     // Create a new wild Pokemon of the specified species and level
-    wild_pokemon = create_pokemon(species, level);
+    create_pokemon(&wild_pokemon, species, level);
+    battle_rng_seed(&battle_rng, furi_hal_random_get());
     
-    FURI_LOG_D("Game", "Wild %s (Lv %d) appeared!", wild_pokemon.name, wild_pokemon.level);
+    FURI_LOG_D("Game", "%s%s (Lv %d) appeared!", enemy_prefix(), battle_text(wild_pokemon.name, name), wild_pokemon.level);
     
     // Reset battle state
     battle_state = BattleStateIntro;
     player_turn = true;
     dialog_box.cursor_position = 0;
     
+    // Give the player a few steps of peace once the battle is over
+    encounter_start_grace(&encounter_state, ENCOUNTER_GRACE_STEPS);
+
     // Switch to battle scene
-    scene_manager.current_scene = SceneBattle;
+    scene_switch(SceneBattle);
+    load_battle_text();
+    sequencer_play_music(&sequencer, &songs[SONG_BATTLE]);
     
     // Initialize battle UI
     update_battle_ui();
 }
 
+// Start a battle with a wild Pokemon
+void start_battle(PokemonSpecies species, int level) {
+    battle_trainer = NULL;
+    battle_trainer_entity = ENTITY_NONE;
+    open_battle(species, level);
+}
+
+// Start a battle against a trainer NPC's party
+static void start_trainer_battle(int entity) {
+    battle_trainer = &trainer_parties[entities.party[entity]];
+    battle_trainer_entity = entity;
+    battle_party_index = 0;
+    open_battle(battle_trainer->species[0], battle_trainer->levels[0]);
+}
+
 bool check_for_encounter(int x, int y) {
-    Tile* current_tile = &CURRENT_MAP->tiles[x / TILE_SIZE][y / TILE_SIZE];
-
-    if (current_tile->spawn_data.spawn_rate > 0) {
-        int roll = rand() % 100; // Roll from 0-99
-        if (roll < current_tile->spawn_data.spawn_rate) {
-            // Randomly pick a Pokémon from the tile's possible spawns
-            int spawn_index = rand() % 3;
-            PokemonSpecies wild_species = current_tile->spawn_data.pokemon[spawn_index];
-            
-            // Random level between min and max for the area
-            int wild_level = current_tile->spawn_data.min_level + 
-                (rand() % (current_tile->spawn_data.max_level - current_tile->spawn_data.min_level + 1));
-                
-            // Start battle with the wild Pokemon
-            start_battle(wild_species, wild_level);
-            return true;
-        }
+    uint8_t zone = map_bits_zone(&CURRENT_MAP->bits, x / TILE_SIZE, y / TILE_SIZE);
+
+    PokemonSpecies wild_species;
+    int wild_level;
+    if (!encounter_roll(&encounter_state, zone, &wild_species, &wild_level)) {
+        return false;
+    }
+
+    // Start battle with the wild Pokemon
+    start_battle(wild_species, wild_level);
+    return true;
+}
+
+
+// ---------------- CUTSCENES ---------------- //
+
+static bool script_dialog(void* ctx, const char* text) {
+    (void)ctx;
+    snprintf(dialog_box.text, sizeof(dialog_box.text), "%s", text);
+    dialog_box.is_active = true;
+    dialog_box.option_count = 0;
+    return true;
+}
+
+static bool script_move_npc(void* ctx, int npc, int direction, int steps) {
+    (void)ctx;
+    if(npc < 0 || npc >= entities.count || direction < 1 || direction > 4 || steps <= 0) {
+        FURI_LOG_W("Script", "No NPC %d to move %d x%d", npc, direction, steps);
+        return false;
     }
+
+    uint8_t path[ENTITY_PATH_MAX];
+    if(steps > ENTITY_PATH_MAX) steps = ENTITY_PATH_MAX;
+    memset(path, direction, steps);
+    entity_pool_set_path(&entities, npc, path, steps);
+    script_npc_pending = npc;
+    return true;
+}
+
+static bool script_give_item(void* ctx, int item, int quantity) {
+    (void)ctx;
+    if(item < 0 || item >= ItemCount) return false;
+    int total = bag[item] + quantity;
+    bag[item] = (uint8_t)clamp(total, 0, 99);
     return false;
 }
 
+static bool script_start_battle(void* ctx, int species, int level) {
+    (void)ctx;
+    if(species < 0 || species >= POKEMON_COUNT) return false;
+    start_battle((PokemonSpecies)species, level);
+    script_battle_pending = true;
+    return true;
+}
+
+static const ScriptHost script_host = {
+    .dialog = script_dialog,
+    .move_npc = script_move_npc,
+    .give_item = script_give_item,
+    .start_battle = script_start_battle,
+};
+
+// Read a map's compiled scripts from the SD card into the cache, once per
+// session. Maps without scripts are fine.
+static void cache_map_scripts(int map_index) {
+    if(map_scripts_read[map_index]) return;
+    map_scripts_read[map_index] = true;
+
+    char path[64];
+    snprintf(path, sizeof(path), APP_ASSETS_PATH("scripts/map_%d.fsb"), map_index);
+    uint32_t failed = script_arena.failed;
+    script_program_load(&map_scripts[map_index], path, &script_arena);
+    if(script_arena.failed != failed) {
+        FURI_LOG_E("Script", "No room to cache the scripts of map %d, raise SCRIPT_CACHE_SIZE", map_index);
+    }
+}
+
+// Swap in the scripts of a map. Only the map at launch is read here, any
+// other one was cached by the prefetch task before its exit opened.
+static void load_map_scripts(int map_index) {
+    cache_map_scripts(map_index);
+    const ScriptProgram* program = &map_scripts[map_index];
+    script_vm_set_program(&script_vm, program->data ? program : NULL);
+}
 
-// The draw callback draws the visible portion of the map and then draws the trainer.
-static void game_draw_callback(Canvas* canvas, void* ctx) {
+// Run a script of the current map as a cutscene
+static void start_cutscene(int script);
+
+// Have the background tasks build the current map's neighbours
+static void queue_map_prefetch(void);
+
+// Spawn the NPCs of a map, trainers whose defeat flag is set no longer watch
+static void load_map_npcs(int map_index) {
+    const MapNpcTable* table = &map_npcs[map_index];
+    entity_pool_clear(&entities);
+    approaching_trainer = ENTITY_NONE;
+    script_npc_pending = ENTITY_NONE;
+
+    for(int i = 0; i < table->count; i++) {
+        const NpcSpawn* spawn = &table->npcs[i];
+        bool defeated = spawn->vision > 0 && script_vm_get_flag(&script_vm, spawn->defeat_flag);
+        entity_pool_add(&entities, spawn, defeated);
+    }
+}
+
+// Set up scripts and NPCs once the player is on a map, then run its entry script
+static void enter_map(int map_index) {
+    // The previous map's data goes away with everything above it
+    scene_release();
+    arena_reset(&scene_manager.arena);
+    load_map_scripts(map_index);
+    scene_manager.map_mark = arena_mark(&scene_manager.arena);
+    load_scene_sprites(scene_manager.current_scene);
+    load_map_npcs(map_index);
+    queue_map_prefetch();
+    start_cutscene(0);
+}
+
+static void start_cutscene(int script) {
+    if(!script_vm_start(&script_vm, script)) return;
+    trainer.held_direction = 0;
+    trainer.queued_direction = 0;
+    scene_switch(SceneCutscene);
+}
+
+// Advance the running script by one logic step
+static void update_cutscene(void) {
+    if(script_npc_pending != ENTITY_NONE) {
+        if(!entity_pool_is_idle(&entities, script_npc_pending)) return;
+        script_npc_pending = ENTITY_NONE;
+        script_vm_resume(&script_vm);
+    }
+
+    if(script_battle_pending) {
+        // Battles hand control back to exploration when they end
+        if(scene_manager.current_scene != SceneExploration) return;
+        script_battle_pending = false;
+        scene_switch(SceneCutscene);
+        script_vm_resume(&script_vm);
+    }
+
+    ScriptStatus status = script_vm_run(&script_vm, SCRIPT_INSTRUCTIONS_PER_TICK);
+    if(status == ScriptStatusError) {
+        FURI_LOG_E("Script", "Script stopped on map %d", current_map_index);
+    }
+    if((status == ScriptStatusIdle || status == ScriptStatusError) && scene_manager.current_scene == SceneCutscene) {
+        dialog_box.is_active = false;
+        scene_switch(SceneExploration);
+    }
+}
+
+static void handle_cutscene_input(PluginEvent* event) {
+    if(event->input.type != InputTypePress) return;
+
+    if(dialog_box.is_active && (event->input.key == InputKeyOk || event->input.key == InputKeyBack)) {
+        dialog_box.is_active = false;
+        script_vm_resume(&script_vm);
+    }
+}
+
+// ---------------- NPCS ---------------- //
+
+// Tile the trainer is standing on, or walking into
+static void player_tile(int* x, int* y) {
+    *x = (trainer.x + trainer.step_dx * trainer.step_phase) / TILE_SIZE;
+    *y = (trainer.y + trainer.step_dy * trainer.step_phase) / TILE_SIZE;
+}
+
+// A trainer spotted the player: walk up next to them, then battle
+static void begin_trainer_approach(int entity) {
+    static const int dir_dx[5] = {0, 0, 1, 0, -1};
+    static const int dir_dy[5] = {0, -1, 0, 1, 0};
+    int px, py;
+    player_tile(&px, &py);
+
+    entity_pool_stop_watching(&entities, entity);
+    approaching_trainer = entity;
+    trainer.held_direction = 0;
+    trainer.queued_direction = 0;
+
+    // Stand on the tile between trainer and player, facing the player
+    int dir = entities.direction[entity];
+    int tx = px - dir_dx[dir];
+    int ty = py - dir_dy[dir];
+    if(tx == entities.x[entity] && ty == entities.y[entity]) return;
+
+    uint8_t path[ENTITY_PATH_MAX];
+    int steps = pathfind(&path_scratch, &CURRENT_MAP->bits, entities.occupied_rows,
+                         entities.x[entity], entities.y[entity], tx, ty, path, ENTITY_PATH_MAX);
+    if(steps > 0) entity_pool_set_path(&entities, entity, path, steps);
+}
+
+// Look for a trainer that can see the player, only called after someone moved
+static void check_trainer_vision(void) {
+    if(approaching_trainer != ENTITY_NONE || scene_manager.current_scene != SceneExploration) return;
+    int px, py;
+    player_tile(&px, &py);
+
+    int spotter = entity_pool_spot_player(&entities, &CURRENT_MAP->bits, px, py);
+    if(spotter != ENTITY_NONE) begin_trainer_approach(spotter);
+}
+
+// Advance NPC movement by one logic step
+static void update_npcs(void) {
+    int px, py;
+    player_tile(&px, &py);
+
+    uint8_t arrived[ENTITY_MAX];
+    int arrived_count = entity_pool_update(&entities, &CURRENT_MAP->bits, px, py, WALK_STEPS, arrived);
+
+    // Only an NPC that just moved can have brought the player into view
+    for(int i = 0; i < arrived_count && approaching_trainer == ENTITY_NONE; i++) {
+        if(scene_manager.current_scene == SceneExploration &&
+           entity_pool_can_see(&entities, &CURRENT_MAP->bits, arrived[i], px, py)) {
+            begin_trainer_approach(arrived[i]);
+        }
+    }
+
+    if(approaching_trainer != ENTITY_NONE && trainer.step_phase == 0 &&
+       entity_pool_is_idle(&entities, approaching_trainer)) {
+        int entity = approaching_trainer;
+        approaching_trainer = ENTITY_NONE;
+        start_trainer_battle(entity);
+    }
+}
+
+// OK on the tile in front of the trainer: talk to whoever stands there
+static void talk_to_npc(void) {
+    static const int dir_dx[5] = {0, 0, 1, 0, -1};
+    static const int dir_dy[5] = {0, -1, 0, 1, 0};
+    int entity = entity_pool_at(&entities, trainer.x / TILE_SIZE + dir_dx[trainer.direction],
+                                trainer.y / TILE_SIZE + dir_dy[trainer.direction]);
+    if(entity == ENTITY_NONE || !entity_pool_is_idle(&entities, entity)) return;
+
+    // Turn to face the player
+    entities.direction[entity] = (trainer.direction + 1) % 4 + 1;
+
+    if(entities.flags[entity] & ENTITY_FLAG_WATCHING) {
+        entity_pool_stop_watching(&entities, entity);
+        start_trainer_battle(entity);
+    } else {
+        start_cutscene(entities.script[entity]);
+    }
+}
+
+static void draw_cutscene_scene(Canvas* canvas) {
+    draw_exploration_scene(canvas);
+    if(dialog_box.is_active) {
+        draw_dialog_text(canvas, 2, SCREEN_HEIGHT - 20, SCREEN_WIDTH - 4, 18);
+    }
+}
+
+#ifdef FLIPPER_MON_BENCH
+// ---------------- BENCHMARKS ---------------- //
+
+#define BENCH_ITERATIONS      1000
+#define BENCH_DRAW_ITERATIONS 100
+#define BENCH_CSV_PATH        APP_DATA_PATH("bench.csv")
+
+static BenchSuite bench_suite;
+static volatile bool bench_draw_pending = true; // Cleared by the draw callback once it ran its part
+static bool bench_written = false;
+static volatile int bench_sink;                 // Keeps lookups from being optimized away
+
+// Battle state the benchmarks overwrite, restored afterwards
+typedef struct {
+    Pokemon player;
+    Pokemon wild;
+    BattleState state;
+    DialogBox dialog;
+} BenchSnapshot;
+
+static void bench_save(BenchSnapshot* snapshot) {
+    *snapshot = (BenchSnapshot){player_pokemon, wild_pokemon, battle_state, dialog_box};
+}
+
+static void bench_restore(const BenchSnapshot* snapshot) {
+    player_pokemon = snapshot->player;
+    wild_pokemon = snapshot->wild;
+    battle_state = snapshot->state;
+    dialog_box = snapshot->dialog;
+}
+
+static void bench_create_pokemon(void* ctx) {
+    create_pokemon((Pokemon*)ctx, POKEMON_CHARMANDER, 12);
+}
+
+static void bench_calculate_damage(void* ctx) {
+    (void)ctx;
+    bench_sink = calculate_damage(player_pokemon.moves[0], &player_pokemon, &wild_pokemon);
+}
+
+static void bench_enemy_turn(void* ctx) {
+    (void)ctx;
+    player_pokemon.current_hp = player_pokemon.max_hp;
+    start_enemy_turn();
+}
+
+// Every move of both sides, as a trainer or a hint would ask for it
+static void bench_damage_outcomes(void* ctx) {
+    DamageOutcome* outcomes = ctx;
+    damage_outcomes(&wild_pokemon, &player_pokemon, outcomes);
+    damage_outcomes(&player_pokemon, &wild_pokemon, outcomes + 4);
+}
+
+// Worst case for one string: the longest one in the pool
+static void bench_text_decode(void* ctx) {
+    text_decode(TEXT_LONGEST, ctx, TEXT_BUFFER_SIZE);
+}
+
+// The same turn headless, no text is formatted
+static void bench_resolve_move(void* ctx) {
+    (void)ctx;
+    player_pokemon.current_hp = player_pokemon.max_hp;
+    pokemon_clear_status(&player_pokemon);
+    battle_events_clear(&battle_events);
+    battle_resolve_move(&battle_events, &battle_rng, BattleSideOpponent, &wild_pokemon, &player_pokemon, 0);
+}
+
+#define BENCH_STATUS_TURNS 32
+
+// Events over BENCH_STATUS_TURNS turns of a Pokemon that a move has just
+// given effect, counted by BattleEventType. HP is topped up every turn so
+// nobody faints.
+static void bench_status_turns(MoveEffect effect, int counts[BattleEventFaint + 1]) {
+    Move move = {TEXT_UNKNOWN, MOVE_TYPE_NORMAL, 0, 100, effect, 100};
+    Pokemon attacker;
+    Pokemon target;
+    create_pokemon(&attacker, POKEMON_BULBASAUR, 10);
+    create_pokemon(&target, POKEMON_PIDGEY, 10);
+    attacker.moves[0] = &move;
+    BattleRng rng;
+    battle_rng_seed(&rng, effect);
+    BattleEventQueue queue;
+    battle_events_clear(&queue);
+    battle_resolve_move(&queue, &rng, BattleSidePlayer, &attacker, &target, 0);
+
+    memset(counts, 0, sizeof(int) * (BattleEventFaint + 1));
+    if(target.status != effect) return;
+    for(int turn = 0; turn < BENCH_STATUS_TURNS; turn++) {
+        target.current_hp = target.max_hp;
+        attacker.current_hp = attacker.max_hp;
+        battle_events_clear(&queue);
+        battle_resolve_move(&queue, &rng, BattleSideOpponent, &target, &attacker, 0);
+        const BattleEvent* event;
+        while((event = battle_events_next(&queue)) != NULL) counts[event->type]++;
+    }
+}
+
+// Every status has to change the turns that follow it, not just its label
+static void bench_status_check(void) {
+    int poison[BattleEventFaint + 1];
+    int burn[BattleEventFaint + 1];
+    int sleep[BattleEventFaint + 1];
+    int paralysis[BattleEventFaint + 1];
+    bench_status_turns(EFFECT_POISON, poison);
+    bench_status_turns(EFFECT_BURN, burn);
+    bench_status_turns(EFFECT_SLEEP, sleep);
+    bench_status_turns(EFFECT_PARALYZE, paralysis);
+
+    bool ok = poison[BattleEventHurt] == BENCH_STATUS_TURNS && burn[BattleEventHurt] == BENCH_STATUS_TURNS &&
+              sleep[BattleEventWokeUp] == 1 && sleep[BattleEventMoveUsed] == BENCH_STATUS_TURNS - 1 - sleep[BattleEventCantMove] &&
+              paralysis[BattleEventCantMove] > 0 && paralysis[BattleEventMoveUsed] == BENCH_STATUS_TURNS - paralysis[BattleEventCantMove];
+    FURI_LOG_I("Battle", "Over %d turns: poison hurt %d, burn hurt %d, asleep %d, paralyzed %d: %s", BENCH_STATUS_TURNS,
+               poison[BattleEventHurt], burn[BattleEventHurt], sleep[BattleEventCantMove] + sleep[BattleEventWokeUp],
+               paralysis[BattleEventCantMove],
+               ok ? "ok" : "FAILED");
+}
+
+#define BENCH_LINK_TURNS      64 // A stuck battle is cut off here
+#define BENCH_LINK_ITERATIONS 100
+
+// Two headless link instances battling each other over the loopback pipe
+typedef struct {
+    LinkLoopback loopback;
+    LinkBattle host;
+    LinkBattle guest;
+    uint32_t seed;
+    int turns;
+} BenchLink;
+
+static BenchLink bench_link; // Too big for the game thread's stack
+
+// One link battle from handshake to the last turn. With corrupt set the
+// guest's copy of the host Pokemon is damaged first, which the state
+// hashes have to catch on the first turn.
+static void bench_link_play(BenchLink* link, bool corrupt) {
+    link_loopback_init(&link->loopback);
+    link->seed++;
+    link_battle_start(&link->host, link_loopback_transport(&link->loopback, 0), LinkRoleHost, POKEMON_BULBASAUR, 20, link->seed);
+    link_battle_start(&link->guest, link_loopback_transport(&link->loopback, 1), LinkRoleGuest, POKEMON_SQUIRTLE, 20, ~link->seed);
+    link_battle_poll(&link->host);
+    link_battle_poll(&link->guest);
+    if(corrupt) link->guest.remote.current_hp--;
+
+    for(link->turns = 0; link->turns < BENCH_LINK_TURNS; link->turns++) {
+        link_battle_choose(&link->host, battle_pick_best_move(&link->host.local, &link->host.remote));
+        link_battle_choose(&link->guest, battle_pick_best_move(&link->guest.local, &link->guest.remote));
+        link_battle_poll(&link->host);
+        link_battle_poll(&link->guest);
+        if(link->host.state != LinkStateTurnDone || link->guest.state != LinkStateTurnDone) break;
+    }
+}
+
+static void bench_link_battle(void* ctx) {
+    bench_link_play(ctx, false);
+}
+
+// Both sides must end the same battle the same way, and a tampered side must be caught
+static void bench_link_check(BenchLink* link) {
+    bench_link_play(link, false);
+    uint32_t per_us = furi_hal_cortex_instructions_per_microsecond();
+    int turns = link->host.turn ? link->host.turn : 1;
+    FURI_LOG_I("Link", "%d turns, states %d/%d, hashes %s, %lu bytes per turn, wait avg %lu us max %lu us", link->host.turn,
+               link->host.state, link->guest.state,
+               link_battle_hash(&link->host) == link_battle_hash(&link->guest) ? "match" : "DIFFER",
+               link->host.bytes_sent / turns, link->host.wait_total / turns / per_us, link->host.wait_max / per_us);
+
+    bench_link_play(link, true);
+    bool caught = link->host.state == LinkStateDesync && link->guest.state == LinkStateDesync;
+    FURI_LOG_I("Link", "Tampered state %s", caught ? "detected by both sides" : "NOT DETECTED");
+}
+
+static void bench_tile_lookup(void* ctx) {
     (void)ctx;
+    int solid = 0;
+    for(int y = 0; y < MAP_HEIGHT; y++) {
+        const uint8_t* row = map_row(CURRENT_MAP, 0, y);
+        for(int x = 0; x < MAP_WIDTH; x++) {
+            solid += tile_defs[row[x]].is_obstacle;
+        }
+    }
+    bench_sink = solid;
+}
+
+static void bench_tile_bits(void* ctx) {
+    (void)ctx;
+    int solid = 0;
+    for(int y = 0; y < MAP_HEIGHT; y++) {
+        for(int x = 0; x < MAP_WIDTH; x++) {
+            solid += map_bits_is_solid(&CURRENT_MAP->bits, x, y);
+        }
+    }
+    bench_sink = solid;
+}
+
+static void bench_draw_exploration_full(void* ctx) {
+    bg_cache_invalidate(&bg_cache);
+    draw_exploration_scene((Canvas*)ctx);
+}
+
+static void bench_draw_exploration_cached(void* ctx) {
+    draw_exploration_scene((Canvas*)ctx);
+}
+
+static void bench_draw_battle_full(void* ctx) {
+    layer_cache_invalidate(&battle_layer);
+    draw_battle_scene((Canvas*)ctx);
+}
+
+static void bench_draw_battle_cached(void* ctx) {
+    draw_battle_scene((Canvas*)ctx);
+}
+
+// Battle sized sprite on an unaligned row, so every page is split over two
+static void bench_draw_masked_sprite(void* ctx) {
+    masked_sprite_draw((Canvas*)ctx, asset_sprite(ASSET_BULBASAUR), 40, 11);
+}
+
+static void bench_draw_dialog(void* ctx) {
+    draw_dialog_text((Canvas*)ctx, 2, SCREEN_HEIGHT - 20, SCREEN_WIDTH - 4, 18);
+}
+
+// Battle math and map access, run on the game thread before the GUI starts
+static void bench_run_logic(void) {
+    ensure_player_pokemon();
+    BenchSnapshot snapshot;
+    bench_save(&snapshot);
+    create_pokemon(&wild_pokemon, POKEMON_PIDGEY, 5);
+    battle_rng_seed(&battle_rng, 1);
+
+    Pokemon scratch;
+    bench_run(&bench_suite, "create_pokemon", bench_create_pokemon, &scratch, BENCH_ITERATIONS, NULL);
+    bench_run(&bench_suite, "calculate_damage", bench_calculate_damage, NULL, BENCH_ITERATIONS, NULL);
+    DamageOutcome outcomes[8];
+    bench_run(&bench_suite, "damage_outcomes_both", bench_damage_outcomes, outcomes, BENCH_ITERATIONS, NULL);
+    bench_run(&bench_suite, "battle_enemy_turn", bench_enemy_turn, NULL, BENCH_ITERATIONS, NULL);
+    bench_run(&bench_suite, "battle_resolve_move", bench_resolve_move, NULL, BENCH_ITERATIONS, NULL);
+    bench_status_check();
+    bench_run(&bench_suite, "link_loopback_battle", bench_link_battle, &bench_link, BENCH_LINK_ITERATIONS, NULL);
+    bench_link_check(&bench_link);
+    char text[TEXT_BUFFER_SIZE];
+    bench_run(&bench_suite, "text_decode_longest", bench_text_decode, text, BENCH_ITERATIONS, NULL);
+    bench_run(&bench_suite, "tile_lookup_map", bench_tile_lookup, NULL, BENCH_ITERATIONS, NULL);
+    bench_run(&bench_suite, "tile_bits_map", bench_tile_bits, NULL, BENCH_ITERATIONS, NULL);
+
+    bench_restore(&snapshot);
+}
+
+// Rendering needs the GUI's canvas, so this runs inside the first draw callback
+static void bench_run_draw(Canvas* canvas) {
+    BenchSnapshot snapshot;
+    bench_save(&snapshot);
+    const volatile uint32_t* canvas_calls = &profiler.canvas_calls;
+
+    bench_run(&bench_suite, "draw_exploration_full", bench_draw_exploration_full, canvas, BENCH_DRAW_ITERATIONS, canvas_calls);
+    bench_run(&bench_suite, "draw_exploration_cached", bench_draw_exploration_cached, canvas, BENCH_DRAW_ITERATIONS, canvas_calls);
+
+    create_pokemon(&wild_pokemon, POKEMON_PIDGEY, 5);
+    battle_state = BattleStateChooseAction;
+    update_battle_ui();
+    bench_run(&bench_suite, "draw_battle_full", bench_draw_battle_full, canvas, BENCH_DRAW_ITERATIONS, canvas_calls);
+    bench_run(&bench_suite, "draw_battle_cached", bench_draw_battle_cached, canvas, BENCH_DRAW_ITERATIONS, canvas_calls);
+
+    bench_run(&bench_suite, "draw_masked_sprite", bench_draw_masked_sprite, canvas, BENCH_DRAW_ITERATIONS, canvas_calls);
+
+    snprintf(dialog_box.text, sizeof(dialog_box.text), "A wild %s\nappeared!", battle_text(wild_pokemon.name, draw_name));
+    bench_run(&bench_suite, "draw_dialog_text", bench_draw_dialog, canvas, BENCH_DRAW_ITERATIONS, canvas_calls);
+
+    bench_restore(&snapshot);
+    bg_cache_invalidate(&bg_cache);
+    canvas_clear(canvas);
+}
+#endif
+
+#ifdef FLIPPER_MON_FRAMECHECK
+static volatile bool framecheck_pending = true;
+static void framecheck_run(Canvas* canvas);
+#endif
+
+static void draw_scene(Canvas* canvas) {
+    PROFILE_SCOPE(ProfileFrame);
     canvas_clear(canvas);
     if (scene_manager.current_scene == SceneExploration) {
         draw_exploration_scene(canvas);
+    } else if (scene_manager.current_scene == SceneCutscene) {
+        draw_cutscene_scene(canvas);
     } else {
         draw_battle_scene(canvas);
     }
 }
 
-void initialize_maps() {
-    // **Route 1 Initialization**
-    maps[0] = (GameMap){ .name = "Route 1", .width = MAP_WIDTH, .height = MAP_HEIGHT };
+// The draw callback draws the visible portion of the map and then draws the trainer.
+static void game_draw_callback(Canvas* canvas, void* ctx) {
+    (void)ctx;
+#ifdef FLIPPER_MON_BENCH
+    if(bench_draw_pending) {
+        bench_run_draw(canvas);
+        bench_draw_pending = false;
+    }
+#endif
+#ifdef FLIPPER_MON_FRAMECHECK
+    if(framecheck_pending) {
+        framecheck_run(canvas);
+        framecheck_pending = false;
+    }
+#endif
+    uint32_t draw_start = DWT->CYCCNT;
+    STACK_PROBE_CALL(&stack_probes[scene_manager.current_scene][StackPathDraw], draw_scene(canvas));
+    PROFILE_DRAW_OVERLAY(canvas);
+    last_draw_cycles = DWT->CYCCNT - draw_start;
+    boot_profile_mark(&boot_profile, BootPhaseFirstFrame);
+}
+
+// Fill a map with grass and a border of obstacles
+static void build_bordered_grass_map(GameMap* map, const char* name, EncounterZoneId grass_zone) {
+    *map = (GameMap){ .name = name, .width = MAP_WIDTH, .height = MAP_HEIGHT, .encounter_zone = grass_zone };
 
     for(int y = 0; y < MAP_HEIGHT; y++) {
+        bool fence_row = (y == 0 || y == MAP_HEIGHT - 1);
         for(int x = 0; x < MAP_WIDTH; x++) {
-            bool is_border = (y == 0 || y == MAP_HEIGHT - 1 || x == 0 || x == MAP_WIDTH - 1);
-            maps[0].tiles[x][y] = (Tile){
-                .x = x,
-                .y = y,
-                .type = TILE_TYPE_GRASS,
-                .is_obstacle = is_border, // Border is obstacle
-                .transition_map_index = -1,
-                .spawn_data = GRASS_PEWTER, // 20% chance of Pokémon spawning
-            };
+            bool is_border = (fence_row || x == 0 || x == MAP_WIDTH - 1);
+            map->tiles[y][x] = fence_row ? TILE_FENCE : is_border ? TILE_BORDER : TILE_GRASS;
         }
     }
-    maps[0].tiles[4][MAP_HEIGHT - 2].transition_map_index = 1;
+}
 
-    // **Pallet Town Initialization**
-    maps[1] = (GameMap){ .name = "Pallet Town", .width = MAP_WIDTH, .height = MAP_HEIGHT };
+// Pack the tiles' obstacle and encounter data into the map's bitsets
+static void build_map_bits(GameMap* map) {
+    map_bits_clear(&map->bits);
 
     for(int y = 0; y < MAP_HEIGHT; y++) {
+        const uint8_t* row = map_row(map, 0, y);
         for(int x = 0; x < MAP_WIDTH; x++) {
-            bool is_border = (y == 0 || y == MAP_HEIGHT - 1 || x == 0 || x == MAP_WIDTH - 1);
-            maps[1].tiles[x][y] = (Tile){
-                .x = x,
-                .y = y,
-                .type = TILE_TYPE_GRASS,
-                .is_obstacle = is_border,
-                .transition_map_index = -1,
-                .spawn_data = GRASS_PEWTER, // 10% chance of Pokémon spawning
-            };
+            const TileDef* tile = &tile_defs[row[x]];
+            map_bits_set_solid(&map->bits, x, y, tile->is_obstacle);
+            map_bits_set_zone(&map->bits, x, y, tile->has_encounters ? map->encounter_zone : ENCOUNTER_ZONE_NONE);
         }
     }
 }
 
+// Build a map's tiles if that has not happened yet
+static void preload_map(int map_index) {
+    GameMap* map = &maps[map_index];
+    if(map->loaded) return;
+
+    switch(map_index) {
+        case 0:
+            build_bordered_grass_map(map, "Route 1", ENCOUNTER_ZONE_ROUTE_1_GRASS);
+            break;
+        case 1:
+            build_bordered_grass_map(map, "Pallet Town", ENCOUNTER_ZONE_PALLET_TOWN_GRASS);
+            break;
+        default:
+            return;
+    }
+    build_map_bits(map);
+    map->loaded = true;
+}
+
+void initialize_maps() {
+    // Neighbours are built by the prefetch task once the first frame is up
+    preload_map(current_map_index);
+}
+
+// Launch work that can wait until the first frame is on screen, one step
+// per slice: scene sprites, then the player's Pokemon.
+#define WARMUP_BUDGET_US 4000
+
+static int warmup_task = SCHEDULER_NONE;
+static uint8_t warmup_step;
+
+static bool warmup_task_step(void* ctx) {
+    (void)ctx;
+    if(warmup_step++ == 0) {
+        scene_sprites_ready = true;
+        load_scene_sprites(scene_manager.current_scene);
+        return false;
+    }
+    ensure_player_pokemon();
+    boot_profile_mark(&boot_profile, BootPhaseWarmup);
+    boot_profile_log(&boot_profile);
+    return true;
+}
+
+// Gets every map the current one has exits to ready: its tiles in one
+// slice, its scripts from the SD card in the next. It is queued again on
+// each map change, and a step onto an exit waits until the destination is
+// ready, so neither happens inside the transition tick.
+#define PREFETCH_BUDGET_US 4000
+
+typedef struct {
+    int task;
+    uint8_t map;   // Map whose exits are being prefetched
+    uint8_t exit;  // Next exit of that map
+    bool scripts;  // The exit's map is built, its scripts are next
+} MapPrefetch;
+
+static MapPrefetch map_prefetch = {.task = SCHEDULER_NONE};
+
+// Tiles built and scripts cached, entering the map costs no loading
+static bool map_ready(int map_index) {
+    return maps[map_index].loaded && map_scripts_read[map_index];
+}
+
+static bool prefetch_task_step(void* ctx) {
+    MapPrefetch* prefetch = ctx;
+    const MapWarpTable* warps = &map_warps[prefetch->map];
+    if(prefetch->exit < warps->count) {
+        int destination = warps->exits[prefetch->exit].destination_map_index;
+        if(prefetch->scripts) {
+            cache_map_scripts(destination);
+            prefetch->exit++;
+        } else {
+            preload_map(destination);
+        }
+        prefetch->scripts = !prefetch->scripts;
+    }
+    return prefetch->exit >= warps->count;
+}
+
+// Start over on the current map's neighbours, also while a run for the
+// previous map is still queued
+static void queue_map_prefetch(void) {
+    map_prefetch.map = current_map_index;
+    map_prefetch.exit = 0;
+    map_prefetch.scripts = false;
+    scheduler_queue(&scheduler, map_prefetch.task);
+}
+
+static void init_background_tasks(void) {
+    scheduler_init(&scheduler);
+    warmup_task = scheduler_add(&scheduler, "warmup", SchedulerPriorityLow, WARMUP_BUDGET_US, warmup_task_step, NULL);
+    map_prefetch.task = scheduler_add(&scheduler, "prefetch", SchedulerPriorityLow, PREFETCH_BUDGET_US, prefetch_task_step, &map_prefetch);
+}
+
+// Key events waiting in the ring take over from background work
+static bool input_pending(void* ctx) {
+    (void)ctx;
+    return input_ring_count(&input_ring) > 0;
+}
+
+// Give background tasks what is left of the tick: its period minus the
+// logic just run, the last frame's draw and some slack for other threads
+static void run_background_tasks(uint32_t tick_start) {
+    // Nothing runs before the first frame is on screen
+    if(!boot_profile_reached(&boot_profile, BootPhaseFirstFrame)) return;
+    if(!boot_profile_reached(&boot_profile, BootPhaseWarmup)) scheduler_queue(&scheduler, warmup_task);
+
+    uint32_t used_us = (DWT->CYCCNT - tick_start + last_draw_cycles) / scheduler.cycles_per_us + BACKGROUND_MARGIN_US;
+    uint32_t budget_us = used_us < TICK_US ? TICK_US - used_us : 0;
+    scheduler_run(&scheduler, budget_us, input_pending, NULL);
+}
+
 bool check_map_transition(int x, int y) {
     int tile_x = x / TILE_SIZE;
     int tile_y = y / TILE_SIZE;
@@ -703,91 +1707,207 @@ bool check_map_transition(int x, int y) {
         return false;
     }
 
-    Tile* current_tile = &CURRENT_MAP->tiles[tile_x][tile_y];
-
     // **Check if the tile is a transition tile**
-    if (current_tile->transition_map_index != -1) {
-        int new_map_index = current_tile->transition_map_index;
+    const MapExit* exit = map_find_exit(current_map_index, tile_x, tile_y);
+    if (exit == NULL) {
+        return false;
+    }
 
-        FURI_LOG_D("Game", "Transitioning from %s to %s", CURRENT_MAP->name, maps[new_map_index].name);
+    // start_step only lets the trainer onto an exit once this is ready
+    if(!map_ready(exit->destination_map_index)) return false;
 
-        // **Update the current map index**
-        current_map_index = new_map_index;
+    FURI_LOG_D("Game", "Transitioning from %s to %s", CURRENT_MAP->name, maps[exit->destination_map_index].name);
 
-        // **Find a valid spawn location in the new map**
-        // Here we place the player at a predefined safe spot (can be adjusted per map)
-        trainer.x = TILE_SIZE * 2;  // Example spawn X position
-        trainer.y = TILE_SIZE * (MAP_HEIGHT / 2);  // Example spawn Y position
+    // **Update the current map index**
+    current_map_index = exit->destination_map_index;
 
-        return true;
-    }
+    trainer.x = TILE_SIZE * exit->destination_x;
+    trainer.y = TILE_SIZE * exit->destination_y;
 
-    return false;
+    enter_map(current_map_index);
+
+    return true;
 }
 
 
-void handle_movement(PluginEvent* event) {
-    // If in battle mode, handle battle input instead
-    if (scene_manager.current_scene == SceneBattle) {
-        handle_battle_input(event);
-        return;
-    }
-    
-    int new_x = trainer.x;
-    int new_y = trainer.y;
-    
-    switch(event->input.key) {
-        case InputKeyUp:
-            new_y -= TILE_SIZE;
-            trainer.direction = 1;
-            break;
-        case InputKeyRight:
-            new_x += TILE_SIZE;
-            trainer.direction = 2;
-            break;
-        case InputKeyDown:
-            new_y += TILE_SIZE;
-            trainer.direction = 3;
-            break;
-        case InputKeyLeft:
-            new_x -= TILE_SIZE;
-            trainer.direction = 4;
-            break;
-        case InputKeyOk:
-            break;
-        case InputKeyBack:
-            break;
-        default:
-            break;
+// Direction (1: up, 2: right, 3: down, 4: left) for a D-pad key, 0 for other keys
+static int direction_for_key(InputKey key) {
+    switch(key) {
+        case InputKeyUp: return 1;
+        case InputKeyRight: return 2;
+        case InputKeyDown: return 3;
+        case InputKeyLeft: return 4;
+        default: return 0;
     }
+}
+
+// Turn the trainer and begin tweening towards the neighbouring tile.
+// Returns false if the tile is blocked, the trainer still turns to face it.
+static bool start_step(int direction) {
+    static const int step_dx[5] = {0, 0, 1, 0, -1};
+    static const int step_dy[5] = {0, -1, 0, 1, 0};
+
+    trainer.direction = direction;
+
+    int new_x = trainer.x + step_dx[direction] * TILE_SIZE;
+    int new_y = trainer.y + step_dy[direction] * TILE_SIZE;
 
     new_x = clamp(new_x, 0, CURRENT_MAP->width * TILE_SIZE - TILE_SIZE);
     new_y = clamp(new_y, 0, CURRENT_MAP->height * TILE_SIZE - TILE_SIZE);
 
+    if(new_x == trainer.x && new_y == trainer.y) return false;
+
     // **Ensure tile indices are within bounds**
     int tile_x = new_x / TILE_SIZE;
     int tile_y = new_y / TILE_SIZE;
 
     if(tile_x < 0 || tile_x >= MAP_WIDTH || tile_y < 0 || tile_y >= MAP_HEIGHT) {
         FURI_LOG_D("Game", "Invalid tile access at (%d, %d)", tile_x, tile_y);
+        return false;
+    }
+
+    if (map_bits_is_solid(&CURRENT_MAP->bits, tile_x, tile_y) || entity_pool_occupied(&entities, tile_x, tile_y)) {
+        FURI_LOG_D("Game", "Blocked by an obstacle!");
+        return false;
+    }
+
+    // An exit opens once the prefetch task has its destination ready,
+    // normally within a few ticks of arriving on the map
+    const MapExit* exit = map_find_exit(current_map_index, tile_x, tile_y);
+    if(exit != NULL && !map_ready(exit->destination_map_index)) {
+        FURI_LOG_D("Game", "Exit waits for map %d to be prefetched", exit->destination_map_index);
+        return false;
+    }
+
+    trainer.step_dx = step_dx[direction] * WALK_SPEED;
+    trainer.step_dy = step_dy[direction] * WALK_SPEED;
+    trainer.step_phase = WALK_STEPS;
+
+    if(walk_stats.awaiting_first_step) {
+        walk_stats.awaiting_first_step = false;
+        walk_stats.last_latency_ms = furi_get_tick() - walk_stats.press_tick;
+        if(walk_stats.last_latency_ms > walk_stats.max_latency_ms) {
+            walk_stats.max_latency_ms = walk_stats.last_latency_ms;
+        }
+        walk_stats.walk_start_tick = furi_get_tick();
+        walk_stats.walk_steps = 0;
+    }
+    walk_stats.walk_steps++;
+    return true;
+}
+
+// Called once the trainer has fully arrived on a tile
+static void finish_step(void) {
+    trainer.step_count++;
+
+    if (check_map_transition(trainer.x, trainer.y)) return;
+
+    if (check_for_encounter(trainer.x, trainer.y)) return;
+
+    check_trainer_vision();
+}
+
+// Advance the walk tween by one logic step. A direction queued or held during
+// the step starts the next one on the same tick, so walking has no gaps.
+static void update_movement(void) {
+    if(trainer.step_phase == 0) {
+        // A held key starts walking once it has been down long enough
+        if(trainer.held_direction && walk_stats.awaiting_first_step &&
+           (int32_t)(furi_get_tick() - walk_stats.press_tick) >= WALK_FIRST_STEP_DELAY_MS) {
+            if(!start_step(trainer.held_direction)) walk_stats.awaiting_first_step = false;
+        }
         return;
     }
 
-    Tile* next_tile = &CURRENT_MAP->tiles[tile_x][tile_y];
+    trainer.x += trainer.step_dx;
+    trainer.y += trainer.step_dy;
+    trainer.step_phase--;
+    if(trainer.step_phase > 0) return;
 
-    if (next_tile->is_obstacle) {
-        FURI_LOG_D("Game", "Blocked by an obstacle!");
+    finish_step();
+    if(scene_manager.current_scene != SceneExploration) {
+        trainer.queued_direction = 0;
+        trainer.held_direction = 0;
+        return;
+    }
+
+    int next_direction = trainer.queued_direction ? trainer.queued_direction : trainer.held_direction;
+    trainer.queued_direction = 0;
+    if(next_direction) start_step(next_direction);
+}
+
+void handle_movement(PluginEvent* event) {
+    PROFILE_SCOPE(ProfileMovement);
+
+#ifdef FLIPPER_MON_PROFILE
+    // Long press on Back shows the profiling HUD in any scene
+    if(event->input.key == InputKeyBack && event->input.type == InputTypeLong) {
+        PROFILE_TOGGLE_OVERLAY();
+        return;
+    }
+#endif
+
+    // If in battle mode, handle battle input instead
+    if (scene_manager.current_scene == SceneBattle) {
+        handle_battle_input(event);
         return;
     }
 
-    if (check_map_transition(new_x, new_y)) return;
+    if (scene_manager.current_scene == SceneCutscene) {
+        handle_cutscene_input(event);
+        return;
+    }
+
+    // A trainer is on their way, the player is frozen until the battle
+    if (approaching_trainer != ENTITY_NONE) return;
+
+    // A short press on Back leaves the game (a long one is the profiling HUD)
+    if (event->input.key == InputKeyBack && event->input.type == InputTypeShort && !script_vm_is_active(&script_vm)) {
+        exit_requested = true;
+        return;
+    }
+
+    if (event->input.key == InputKeyOk && event->input.type == InputTypePress && trainer.step_phase == 0) {
+        talk_to_npc();
+        return;
+    }
 
-    if (!check_for_encounter(new_x, new_y)) {
-        new_x = clamp(new_x, 0, full_map_width_pixels() - TILE_SIZE);
-        new_y = clamp(new_y, 0, full_map_height_pixels() - TILE_SIZE);
-        trainer.x = new_x;
-        trainer.y = new_y;
-        anim_frame++;
+    int direction = direction_for_key(event->input.key);
+    if(direction == 0) return;
+
+    switch(event->input.type) {
+        case InputTypePress:
+            trainer.held_direction = direction;
+            walk_stats.press_tick = event->tick;
+            walk_stats.awaiting_first_step = true;
+            if(trainer.step_phase > 0) {
+                // Remember the key until the current step lands
+                trainer.queued_direction = direction;
+            } else if(WALK_FIRST_STEP_DELAY_MS == 0) {
+                start_step(direction);
+            } else {
+                trainer.direction = direction;
+            }
+            break;
+        case InputTypeLong:
+        case InputTypeRepeat:
+            // The key is still down: recover a missed press and retry a blocked step
+            trainer.held_direction = direction;
+            if(trainer.step_phase == 0) start_step(direction);
+            break;
+        case InputTypeRelease:
+            if(trainer.held_direction != direction) break;
+            trainer.held_direction = 0;
+            walk_stats.awaiting_first_step = false;
+            if(walk_stats.walk_steps > 1) {
+                FURI_LOG_D("Game", "Walked %lu tiles in %lu ms, first step after %lu ms (max %lu ms)",
+                           walk_stats.walk_steps, furi_get_tick() - walk_stats.walk_start_tick,
+                           walk_stats.last_latency_ms, walk_stats.max_latency_ms);
+            }
+            walk_stats.walk_steps = 0;
+            break;
+        default:
+            break;
     }
 }
 
@@ -796,18 +1916,130 @@ void update_game_state(void) {
     // Update animations
     if(scene_manager.current_scene == SceneBattle) {
         update_battle_animation();
+    } else if(scene_manager.current_scene == SceneExploration) {
+        update_movement();
     }
+
+    if(scene_manager.current_scene == SceneExploration || scene_manager.current_scene == SceneCutscene) {
+        update_npcs();
+    }
+
+    if(script_vm_is_active(&script_vm)) {
+        update_cutscene();
+    }
+}
+
+#ifdef FLIPPER_MON_FRAMECHECK
+// ---------------- FRAME CHECK ---------------- //
+
+#define FRAMECHECK_CAMERA_STEP 1 // Pixels between swept camera positions
+
+static void framecheck_capture(FrameCheck* check, Canvas* canvas, const char* name) {
+    framecheck_frame(check, canvas_get_buffer(canvas), canvas_get_buffer_size(canvas), name);
 }
 
-// Input callback: post key events to the message queue.
+// Render a fixed script of scenes through the real draw code: the overworld
+// at every camera offset of every map, then each battle and dialog screen.
+// Runs in the first draw callback, the game loop is held until it is done.
+static void framecheck_run(Canvas* canvas) {
+    FrameCheck check;
+    if(!framecheck_open(&check)) return;
+
+    Trainer saved_trainer = trainer;
+    int saved_map = current_map_index;
+    Pokemon saved_player = player_pokemon;
+    Pokemon saved_wild = wild_pokemon;
+    BattleState saved_state = battle_state;
+    DialogBox saved_dialog = dialog_box;
+    uint32_t start = furi_get_tick();
+
+    trainer = (Trainer){.direction = 3};
+    for(int map = 0; map < MAX_MAPS; map++) {
+        preload_map(map);
+        if(!maps[map].loaded) continue;
+        current_map_index = map;
+        load_map_npcs(map);
+        bg_cache_invalidate(&bg_cache);
+
+        char name[8];
+        snprintf(name, sizeof(name), "map%d", map);
+        // Consecutive frames move the camera by one pixel, the background cache's scroll path
+        for(int y = 0; y <= full_map_height_pixels() - SCREEN_HEIGHT; y += FRAMECHECK_CAMERA_STEP) {
+            for(int x = 0; x <= full_map_width_pixels() - SCREEN_WIDTH; x += FRAMECHECK_CAMERA_STEP) {
+                trainer.x = x + SCREEN_WIDTH / 2;
+                trainer.y = y + SCREEN_HEIGHT / 2;
+                draw_exploration_scene(canvas);
+                framecheck_capture(&check, canvas, name);
+            }
+        }
+    }
+
+    create_pokemon(&player_pokemon, POKEMON_BULBASAUR, 5);
+    create_pokemon(&wild_pokemon, POKEMON_PIDGEY, 4);
+    static const BattleState battle_states[] = {
+        BattleStateIntro, BattleStateChooseAction, BattleStateChooseMove, BattleStateEnd,
+    };
+    for(size_t i = 0; i < COUNT_OF(battle_states); i++) {
+        battle_state = battle_states[i];
+        update_battle_ui();
+        canvas_clear(canvas);
+        draw_battle_scene(canvas);
+        framecheck_capture(&check, canvas, "battle");
+    }
+
+    snprintf(dialog_box.text, sizeof(dialog_box.text), "Hey! Wild Pokemon\nlive in tall grass.");
+    dialog_box.is_active = true;
+    canvas_clear(canvas);
+    draw_cutscene_scene(canvas);
+    framecheck_capture(&check, canvas, "dialog");
+
+    FURI_LOG_I("Frames", "%lu frames in %lu ms", check.frames, furi_get_tick() - start);
+    framecheck_close(&check);
+
+    trainer = saved_trainer;
+    current_map_index = saved_map;
+    player_pokemon = saved_player;
+    wild_pokemon = saved_wild;
+    battle_state = saved_state;
+    dialog_box = saved_dialog;
+    load_map_npcs(current_map_index);
+    bg_cache_invalidate(&bg_cache);
+    canvas_clear(canvas);
+}
+#endif
+
+// Input callback: store the key event in the ring and wake the game loop.
+// Never blocks, if the queue is full a pending tick will drain the ring anyway.
 static void input_callback(InputEvent* input_event, void* ctx) {
     FuriMessageQueue* event_queue = (FuriMessageQueue*)ctx;
-    PluginEvent event = { .type = EventTypeKey, .input = *input_event };
-    furi_message_queue_put(event_queue, &event, FuriWaitForever);
+    if(!input_ring_push(&input_ring, input_event, furi_get_tick())) return;
+    PluginEvent event = { .type = EventTypeKey };
+    furi_message_queue_put(event_queue, &event, 0);
+}
+
+// Feed every buffered key event to the current scene
+static void drain_input_ring(void) {
+    InputRingEvent ring_event;
+    while(input_ring_pop(&input_ring, &ring_event)) {
+        PluginEvent event = {
+            .type = EventTypeKey,
+            .input = { .key = ring_event.key, .type = ring_event.type },
+            .tick = ring_event.tick,
+        };
+        STACK_PROBE_CALL(&stack_probes[scene_manager.current_scene][StackPathInput], handle_movement(&event));
+    }
+}
+
+// Timer callback: post a logic tick, dropped if the game is still busy with the last one.
+static void tick_callback(void* ctx) {
+    FuriMessageQueue* event_queue = (FuriMessageQueue*)ctx;
+    PluginEvent event = { .type = EventTypeTick };
+    furi_message_queue_put(event_queue, &event, 0);
 }
 
 int32_t app_main(void* p) {
     (void)p;
+    boot_profile_start(&boot_profile);
     // Allocate a message queue for PluginEvents.
     FuriMessageQueue* event_queue = furi_message_queue_alloc(8, sizeof(PluginEvent));
     if(!event_queue) {
@@ -815,11 +2047,34 @@ int32_t app_main(void* p) {
         return 1;
     }
 
-    // Initialize player's Pokemon - starting with Bulbasaur level 5
-    player_pokemon = create_pokemon(POKEMON_BULBASAUR, 5);
-    
-    // **Initialize maps before anything else**
+    if(!arena_init(&scene_manager.arena, SCENE_ARENA_SIZE)) {
+        FURI_LOG_E("App", "Failed to allocate scene arena");
+        furi_message_queue_free(event_queue);
+        return 1;
+    }
+    if(!arena_init(&script_arena, SCRIPT_CACHE_SIZE)) {
+        FURI_LOG_E("App", "Failed to allocate script cache");
+        arena_free(&scene_manager.arena);
+        furi_message_queue_free(event_queue);
+        return 1;
+    }
+    boot_profile_mark(&boot_profile, BootPhaseAlloc);
+
+    // Only the current map and the HUD are set up before the first frame,
+    // the rest is created on first use or by the background tasks
     initialize_maps();
+    bg_cache_invalidate(&bg_cache);
+    boot_profile_mark(&boot_profile, BootPhaseMap);
+
+    PROFILE_INIT();
+    init_background_tasks();
+    script_vm_init(&script_vm, &script_host);
+    enter_map(current_map_index);
+    boot_profile_mark(&boot_profile, BootPhaseScene);
+
+#ifdef FLIPPER_MON_BENCH
+    bench_run_logic();
+#endif
 
     Gui* gui = furi_record_open(RECORD_GUI);
     ViewPort* view_port = view_port_alloc();
@@ -827,29 +2082,75 @@ int32_t app_main(void* p) {
     view_port_input_callback_set(view_port, input_callback, event_queue);
     gui_add_view_port(gui, view_port, GuiLayerFullscreen);
 
+    // Fixed rate logic ticks drive movement tweens and animations
+    FuriTimer* tick_timer = furi_timer_alloc(tick_callback, FuriTimerTypePeriodic, event_queue);
+    furi_timer_start(tick_timer, furi_kernel_get_tick_frequency() / LOGIC_HZ);
+
+#ifdef FLIPPER_MON_SOUND_LOG
+    sequencer_start(&sequencer, sequencer_log_output());
+#else
+    sequencer_start(&sequencer, sequencer_speaker_output());
+#endif
+    sequencer_play_music(&sequencer, &songs[SONG_OVERWORLD]);
+    boot_profile_mark(&boot_profile, BootPhaseGui);
 
     bool running = true;
     PluginEvent event;
     while(running) {
-        // Wait for an event (100ms timeout).
-        if(furi_message_queue_get(event_queue, &event, 100) == FuriStatusOk) {
-            if(event.type == EventTypeKey && event.input.type == InputTypePress) {
-                handle_movement(&event);
-            }
+        if(furi_message_queue_get(event_queue, &event, FuriWaitForever) != FuriStatusOk) continue;
+        PROFILE_QUEUE_DEPTH(furi_message_queue_get_count(event_queue) + 1);
+
+#ifdef FLIPPER_MON_FRAMECHECK
+        if(framecheck_pending) {
+            view_port_update(view_port);
+            continue;
+        }
+#endif
+#ifdef FLIPPER_MON_BENCH
+        // The game holds still until the draw benchmarks ran, then the results are saved once
+        if(bench_draw_pending) {
+            view_port_update(view_port);
+            continue;
+        }
+        if(!bench_written) {
+            bench_written = true;
+            bench_write_csv(&bench_suite, BENCH_CSV_PATH);
         }
+#endif
 
-         // Update game state - add this
-        update_game_state();
-        
-        view_port_update(view_port);
+        drain_input_ring();
+        if(exit_requested) {
+            running = false;
+            continue;
+        }
+
+        if(event.type == EventTypeTick) {
+            uint32_t tick_start = DWT->CYCCNT;
+            STACK_PROBE_CALL(&stack_probes[scene_manager.current_scene][StackPathLogic], update_game_state());
+            view_port_update(view_port);
+            run_background_tasks(tick_start);
+        }
     }
 
     // Clean up: disable callbacks before freeing resources.
+    sequencer_stop(&sequencer);
+    furi_timer_stop(tick_timer);
+    furi_timer_free(tick_timer);
     view_port_input_callback_set(view_port, NULL, NULL);
     view_port_enabled_set(view_port, false);
     gui_remove_view_port(gui, view_port);
     view_port_free(view_port);
     furi_message_queue_free(event_queue);
     furi_record_close(RECORD_GUI);
+
+    scene_release();
+    FURI_LOG_I("Arena", "Peak %u of %u bytes, %lu failed allocations", (unsigned)scene_manager.arena.peak,
+               (unsigned)scene_manager.arena.capacity, scene_manager.arena.failed);
+    arena_free(&scene_manager.arena);
+    FURI_LOG_I("Script", "Cached %u of %u bytes", (unsigned)script_arena.used, (unsigned)script_arena.capacity);
+    arena_free(&script_arena);
+    scheduler_log(&scheduler);
+
+    STACK_PROBES_LOG();
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,133 @@
+#include "framecheck.h"
+
+#ifdef FLIPPER_MON_FRAMECHECK
+
+#include <furi.h>
+#include <storage/storage.h>
+#include <stdio.h>
+#include <string.h>
+
+#define FRAME_WIDTH  128
+#define FRAME_HEIGHT 64
+#define GOLDEN_PATH  FRAMECHECK_DIR "/golden.bin"
+
+uint64_t framecheck_hash(const uint8_t* data, size_t size) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for(size_t i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+bool framecheck_open(FrameCheck* check) {
+    memset(check, 0, sizeof(FrameCheck));
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    storage_simply_mkdir(storage, FRAMECHECK_DIR);
+
+    File* golden = storage_file_alloc(storage);
+    if(storage_file_open(golden, GOLDEN_PATH, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        check->recording = false;
+    } else if(storage_file_open(golden, GOLDEN_PATH, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+        check->recording = true;
+        FURI_LOG_I("Frames", "No golden frames, recording %s", GOLDEN_PATH);
+    } else {
+        FURI_LOG_E("Frames", "Cannot open %s", GOLDEN_PATH);
+        storage_file_free(golden);
+        furi_record_close(RECORD_STORAGE);
+        return false;
+    }
+
+    check->storage = storage;
+    check->golden = golden;
+    return true;
+}
+
+static void flush_chunk(FrameCheck* check) {
+    if(check->chunk_count == 0) return;
+    storage_file_write(check->golden, check->chunk, check->chunk_count * sizeof(uint64_t));
+    check->chunk_count = 0;
+}
+
+// Next golden hash, false once the file has run out
+static bool next_golden(FrameCheck* check, uint64_t* hash) {
+    if(check->chunk_pos == check->chunk_count) {
+        size_t read = storage_file_read(check->golden, check->chunk, sizeof(check->chunk));
+        check->chunk_count = read / sizeof(uint64_t);
+        check->chunk_pos = 0;
+        if(check->chunk_count == 0) return false;
+    }
+    *hash = check->chunk[check->chunk_pos++];
+    return true;
+}
+
+// Binary PBM, rows MSB first with 1 for a black pixel
+static void dump_pbm(FrameCheck* check, const uint8_t* buffer, const char* name) {
+    char path[96];
+    snprintf(path, sizeof(path), FRAMECHECK_DIR "/%s_%lu.pbm", name, check->frames);
+
+    File* file = storage_file_alloc(check->storage);
+    if(storage_file_open(file, path, FSAM_WRITE, FSOM_CREATE_ALWAYS)) {
+        static const char header[] = "P4\n128 64\n";
+        storage_file_write(file, header, sizeof(header) - 1);
+
+        uint8_t row[FRAME_WIDTH / 8];
+        for(int y = 0; y < FRAME_HEIGHT; y++) {
+            // u8g2 pages hold 8 rows, one byte per column with the top row in bit 0
+            const uint8_t* page = buffer + (y / 8) * FRAME_WIDTH;
+            memset(row, 0, sizeof(row));
+            for(int x = 0; x < FRAME_WIDTH; x++) {
+                if((page[x] >> (y % 8)) & 1) row[x / 8] |= 0x80 >> (x % 8);
+            }
+            storage_file_write(file, row, sizeof(row));
+        }
+        storage_file_close(file);
+        FURI_LOG_W("Frames", "Wrote %s", path);
+    }
+    storage_file_free(file);
+}
+
+void framecheck_frame(FrameCheck* check, const uint8_t* buffer, size_t size, const char* name) {
+    uint64_t hash = framecheck_hash(buffer, size);
+
+    if(check->recording) {
+        check->chunk[check->chunk_count++] = hash;
+        if(check->chunk_count == FRAMECHECK_CHUNK) flush_chunk(check);
+    } else {
+        uint64_t golden;
+        if(!next_golden(check, &golden) || golden != hash) {
+            check->mismatches++;
+            if(check->dumps < FRAMECHECK_MAX_DUMPS && size == FRAME_WIDTH * FRAME_HEIGHT / 8) {
+                check->dumps++;
+                dump_pbm(check, buffer, name);
+            }
+        }
+    }
+    check->frames++;
+}
+
+bool framecheck_close(FrameCheck* check) {
+    if(check->recording) flush_chunk(check);
+
+    // Leftover golden hashes mean frames were dropped from the script
+    uint64_t golden;
+    if(!check->recording && next_golden(check, &golden)) {
+        FURI_LOG_E("Frames", "Golden file has more frames than were rendered");
+        check->mismatches++;
+    }
+
+    storage_file_close(check->golden);
+    storage_file_free(check->golden);
+    furi_record_close(RECORD_STORAGE);
+
+    if(check->recording) {
+        FURI_LOG_I("Frames", "Recorded %lu frames", check->frames);
+    } else if(check->mismatches == 0) {
+        FURI_LOG_I("Frames", "All %lu frames match", check->frames);
+    } else {
+        FURI_LOG_E("Frames", "%lu of %lu frames differ", check->mismatches, check->frames);
+    }
+    return check->mismatches == 0;
+}
+
+#endif // FLIPPER_MON_FRAMECHECK
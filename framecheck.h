@@ -0,0 +1,41 @@
+// framecheck.h - Golden frame hashes for catching rendering regressions, built with -DFLIPPER_MON_FRAMECHECK
+#ifndef FRAMECHECK_H
+#define FRAMECHECK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <storage/storage.h>
+
+#define FRAMECHECK_DIR        APP_DATA_PATH("framecheck")
+#define FRAMECHECK_CHUNK      64 // Hashes read or written per storage call
+#define FRAMECHECK_MAX_DUMPS  8  // PBM images written per run
+
+// The golden file is the little endian 64-bit hash of every frame in
+// render order. Without one the run records it; delete it to re-record
+// after an intended rendering change.
+typedef struct {
+    Storage* storage;
+    File* golden;
+    bool recording;
+    uint64_t chunk[FRAMECHECK_CHUNK];
+    int chunk_count; // Hashes in chunk (recording) or hashes left to compare
+    int chunk_pos;
+    uint32_t frames;
+    uint32_t mismatches;
+    uint32_t dumps;
+} FrameCheck;
+
+// FNV-1a over a frame buffer
+uint64_t framecheck_hash(const uint8_t* data, size_t size);
+
+bool framecheck_open(FrameCheck* check);
+
+// Hash a 128x64 u8g2 page buffer, compare or record it; mismatching frames
+// are written as name_index.pbm next to the golden file
+void framecheck_frame(FrameCheck* check, const uint8_t* buffer, size_t size, const char* name);
+
+// Flush, log the summary and return true if every frame matched
+bool framecheck_close(FrameCheck* check);
+
+#endif // FRAMECHECK_H
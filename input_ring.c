@@ -0,0 +1,46 @@
+#include "input_ring.h"
+
+#define INPUT_RING_MASK (INPUT_RING_SIZE - 1)
+
+_Static_assert((INPUT_RING_SIZE & INPUT_RING_MASK) == 0, "INPUT_RING_SIZE must be a power of two");
+
+bool input_ring_push(InputRing* ring, const InputEvent* event, uint32_t tick) {
+    uint32_t head = ring->head;
+    uint32_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+
+    if(event->type == InputTypeRepeat && head != tail) {
+        // The consumer may take the previous event while we look at it, in
+        // that case it has just seen the same "still held" information.
+        const InputRingEvent* last = &ring->events[(head - 1) & INPUT_RING_MASK];
+        if(last->key == event->key && (last->type == InputTypeRepeat || last->type == InputTypeLong)) {
+            ring->coalesced++;
+            return true;
+        }
+    }
+
+    if(head - tail >= INPUT_RING_SIZE) {
+        ring->dropped++;
+        return false;
+    }
+
+    InputRingEvent* slot = &ring->events[head & INPUT_RING_MASK];
+    slot->key = event->key;
+    slot->type = event->type;
+    slot->tick = tick;
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+bool input_ring_pop(InputRing* ring, InputRingEvent* out) {
+    uint32_t tail = ring->tail;
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    if(head == tail) return false;
+
+    *out = ring->events[tail & INPUT_RING_MASK];
+    __atomic_store_n(&ring->tail, tail + 1, __ATOMIC_RELEASE);
+    return true;
+}
+
+uint32_t input_ring_count(const InputRing* ring) {
+    return __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE) - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+}
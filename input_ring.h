@@ -0,0 +1,37 @@
+// input_ring.h - Lock-free single producer / single consumer ring for key events
+#ifndef INPUT_RING_H
+#define INPUT_RING_H
+
+#include <input/input.h>
+
+#define INPUT_RING_SIZE 16 // Must be a power of two
+
+// Key event as stored in the ring
+typedef struct {
+    InputKey key;
+    InputType type;
+    uint32_t tick; // furi_get_tick() when the event arrived
+} InputRingEvent;
+
+// The input callback is the only producer and the game loop the only consumer.
+// head and tail are free running counters, each written by one side only.
+typedef struct {
+    InputRingEvent events[INPUT_RING_SIZE];
+    uint32_t head;
+    uint32_t tail;
+    uint32_t dropped;   // Events lost because the ring was full
+    uint32_t coalesced; // Repeats merged into an unread event for the same key
+} InputRing;
+
+// Producer side, never blocks. A repeat of a key whose last unread event is
+// already a long press or repeat is dropped since it carries no new state.
+// Returns false if the event did not make it into the ring.
+bool input_ring_push(InputRing* ring, const InputEvent* event, uint32_t tick);
+
+// Consumer side. Returns false when the ring is empty.
+bool input_ring_pop(InputRing* ring, InputRingEvent* out);
+
+// Number of unread events
+uint32_t input_ring_count(const InputRing* ring);
+
+#endif // INPUT_RING_H
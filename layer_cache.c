@@ -0,0 +1,25 @@
+#include "layer_cache.h"
+#include <string.h>
+
+void layer_cache_invalidate(LayerCache* cache) {
+    cache->valid = false;
+}
+
+void layer_cache_draw(LayerCache* cache, Canvas* canvas, uint32_t key, LayerCacheDraw draw, void* ctx) {
+    uint8_t* screen = canvas_get_buffer(canvas);
+    bool cacheable = canvas_get_buffer_size(canvas) == LAYER_CACHE_SIZE;
+
+    if(cacheable && cache->valid && cache->key == key) {
+        memcpy(screen, cache->pixels, LAYER_CACHE_SIZE);
+        return;
+    }
+
+    canvas_clear(canvas);
+    canvas_set_color(canvas, ColorBlack);
+    draw(canvas, ctx);
+    if(cacheable) {
+        memcpy(cache->pixels, screen, LAYER_CACHE_SIZE);
+        cache->key = key;
+        cache->valid = true;
+    }
+}
@@ -0,0 +1,29 @@
+// layer_cache.h - Pre-rendered static screen layer restored with one copy
+#ifndef LAYER_CACHE_H
+#define LAYER_CACHE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <gui/gui.h>
+
+#define LAYER_CACHE_SIZE (128 * 64 / 8)
+
+// Draws everything that stays put while the key is unchanged
+typedef void (*LayerCacheDraw)(Canvas* canvas, void* ctx);
+
+// Last rendered static layer and the key it was drawn for
+typedef struct {
+    uint8_t pixels[LAYER_CACHE_SIZE];
+    uint32_t key;
+    bool valid;
+} LayerCache;
+
+// Force a redraw on the next frame
+void layer_cache_invalidate(LayerCache* cache);
+
+// Replace the canvas contents with the layer for key. The layer is only
+// drawn through draw when the key differs from the cached one; otherwise
+// this is a single memcpy into the display buffer.
+void layer_cache_draw(LayerCache* cache, Canvas* canvas, uint32_t key, LayerCacheDraw draw, void* ctx);
+
+#endif // LAYER_CACHE_H
@@ -0,0 +1,204 @@
+#include "link.h"
+#include <furi.h>
+#include <furi_hal.h>
+#include <string.h>
+
+#define LINK_LEVEL_MAX 100
+
+static void put_u32(uint8_t* p, uint32_t value) {
+    p[0] = value & 0xFF;
+    p[1] = (value >> 8) & 0xFF;
+    p[2] = (value >> 16) & 0xFF;
+    p[3] = value >> 24;
+}
+
+static uint32_t get_u32(const uint8_t* p) {
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static void send_packet(LinkBattle* link, LinkPacketType type, int arg0, int arg1, uint32_t value) {
+    uint8_t packet[LINK_PACKET_SIZE] = {type, link->turn, (uint8_t)arg0, (uint8_t)arg1};
+    put_u32(&packet[4], value);
+    if(!link->transport.send(link->transport.ctx, packet, sizeof(packet))) {
+        link->state = LinkStateError;
+        return;
+    }
+    link->bytes_sent += sizeof(packet);
+}
+
+// Both sides walk the Pokemon in role order, so hashes and turn order agree
+static Pokemon* role_pokemon(LinkBattle* link, LinkRole role) {
+    return role == link->role ? &link->local : &link->remote;
+}
+
+static int role_move(const LinkBattle* link, LinkRole role) {
+    return role == link->role ? link->local_move : link->remote_move;
+}
+
+// FNV-1a over the fields that change during a battle
+static uint32_t hash_bytes(uint32_t hash, const void* data, size_t size) {
+    const uint8_t* bytes = data;
+    for(size_t i = 0; i < size; i++) {
+        hash = (hash ^ bytes[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static uint32_t hash_pokemon(uint32_t hash, const Pokemon* pokemon) {
+    int32_t fields[5] = {pokemon->species, pokemon->level, pokemon->current_hp, pokemon->status, pokemon->status_turns};
+    return hash_bytes(hash, fields, sizeof(fields));
+}
+
+uint32_t link_battle_hash(const LinkBattle* link) {
+    bool host = link->role == LinkRoleHost;
+    uint32_t hash = 2166136261u;
+    hash = hash_bytes(hash, &link->turn, sizeof(link->turn));
+    hash = hash_bytes(hash, &link->rng.state, sizeof(link->rng.state));
+    hash = hash_pokemon(hash, host ? &link->local : &link->remote);
+    return hash_pokemon(hash, host ? &link->remote : &link->local);
+}
+
+void link_battle_start(LinkBattle* link, LinkTransport transport, LinkRole role, PokemonSpecies species, int level, uint32_t nonce) {
+    memset(link, 0, sizeof(LinkBattle));
+    link->transport = transport;
+    link->role = role;
+    link->state = LinkStateHandshake;
+    link->local_move = -1;
+    link->remote_move = -1;
+    link->nonce = nonce;
+    create_pokemon(&link->local, species, level);
+    send_packet(link, LinkPacketHello, species, level, nonce);
+}
+
+// Faster Pokemon first, the host's on a tie; a fainted one does not move
+static void resolve_turn(LinkBattle* link) {
+    Pokemon* host = role_pokemon(link, LinkRoleHost);
+    Pokemon* guest = role_pokemon(link, LinkRoleGuest);
+    LinkRole first = guest->speed > host->speed ? LinkRoleGuest : LinkRoleHost;
+
+    battle_events_clear(&link->events);
+    for(int i = 0; i < 2; i++) {
+        LinkRole role = i == 0 ? first : (LinkRole)!first;
+        Pokemon* attacker = role_pokemon(link, role);
+        Pokemon* defender = role_pokemon(link, (LinkRole)!role);
+        if(attacker->current_hp <= 0) break;
+        BattleSide side = role == link->role ? BattleSidePlayer : BattleSideOpponent;
+        battle_resolve_move(&link->events, &link->rng, side, attacker, defender, role_move(link, role));
+    }
+
+    uint32_t wait = DWT->CYCCNT - link->sent_at;
+    link->wait_total += wait;
+    if(wait > link->wait_max) link->wait_max = wait;
+
+    link->turn++;
+    link->local_move = -1;
+    link->remote_move = -1;
+    link->state = (host->current_hp <= 0 || guest->current_hp <= 0) ? LinkStateOver : LinkStateTurnDone;
+}
+
+static void handle_packet(LinkBattle* link, const uint8_t* packet) {
+    uint8_t type = packet[0];
+    uint8_t turn = packet[1];
+
+    if(type == LinkPacketHello && link->state == LinkStateHandshake) {
+        int species = packet[2];
+        int level = packet[3];
+        if(species >= POKEMON_COUNT || level < 1 || level > LINK_LEVEL_MAX) {
+            link->state = LinkStateError;
+            return;
+        }
+        create_pokemon(&link->remote, (PokemonSpecies)species, level);
+        // Each side brings half of the seed, mixed in role order
+        uint32_t remote_nonce = get_u32(&packet[4]);
+        uint32_t host_nonce = link->role == LinkRoleHost ? link->nonce : remote_nonce;
+        uint32_t guest_nonce = link->role == LinkRoleHost ? remote_nonce : link->nonce;
+        battle_rng_seed(&link->rng, host_nonce * 2654435761u ^ guest_nonce);
+        link->state = LinkStateChoose;
+        return;
+    }
+
+    if(type == LinkPacketAction && link->state != LinkStateHandshake && link->remote_move < 0) {
+        int slot = packet[2];
+        // In lockstep the peer is never a turn ahead or behind
+        if(turn != link->turn || slot >= 4 || link->remote.moves[slot] == NULL) {
+            link->state = LinkStateError;
+            return;
+        }
+        link->remote_hash = get_u32(&packet[4]);
+        uint32_t hash = link_battle_hash(link);
+        if(link->remote_hash != hash) {
+            FURI_LOG_W("Link", "Turn %u: state hash %08lx, peer sent %08lx", link->turn, hash, link->remote_hash);
+            send_packet(link, LinkPacketDesync, 0, 0, hash);
+            link->state = LinkStateDesync;
+            return;
+        }
+        link->remote_move = slot;
+        return;
+    }
+
+    if(type == LinkPacketDesync) {
+        link->remote_hash = get_u32(&packet[4]);
+        FURI_LOG_W("Link", "Turn %u: peer reports a desync, its state hash %08lx", turn, link->remote_hash);
+        link->state = LinkStateDesync;
+        return;
+    }
+
+    link->state = LinkStateError;
+}
+
+LinkState link_battle_poll(LinkBattle* link) {
+    while(link->state != LinkStateError && link->state != LinkStateDesync && link->state != LinkStateOver) {
+        size_t got = link->transport.receive(link->transport.ctx, &link->rx[link->rx_len], LINK_PACKET_SIZE - link->rx_len);
+        if(got == 0) break;
+        link->bytes_received += got;
+        link->rx_len += got;
+        if(link->rx_len < LINK_PACKET_SIZE) continue;
+        link->rx_len = 0;
+        handle_packet(link, link->rx);
+        if(link->state == LinkStateWaiting && link->remote_move >= 0) resolve_turn(link);
+    }
+    return link->state;
+}
+
+bool link_battle_choose(LinkBattle* link, int slot) {
+    if(link->state != LinkStateChoose && link->state != LinkStateTurnDone) return false;
+    if(slot < 0 || slot >= 4 || link->local.moves[slot] == NULL) return false;
+
+    link->local_move = slot;
+    link->state = LinkStateWaiting;
+    link->sent_at = DWT->CYCCNT;
+    send_packet(link, LinkPacketAction, slot, 0, link_battle_hash(link));
+    // The peer may have chosen first
+    if(link->state == LinkStateWaiting && link->remote_move >= 0) resolve_turn(link);
+    return link->state != LinkStateError;
+}
+
+// ---------------- LOOPBACK ---------------- //
+
+static bool loopback_send(void* ctx, const uint8_t* data, size_t size) {
+    LinkLoopbackPipe* pipe = ((LinkLoopbackEnd*)ctx)->tx;
+    if(LINK_LOOPBACK_SIZE - (pipe->head - pipe->tail) < size) return false;
+    for(size_t i = 0; i < size; i++) {
+        pipe->data[pipe->head++ & (LINK_LOOPBACK_SIZE - 1)] = data[i];
+    }
+    return true;
+}
+
+static size_t loopback_receive(void* ctx, uint8_t* data, size_t size) {
+    LinkLoopbackPipe* pipe = ((LinkLoopbackEnd*)ctx)->rx;
+    size_t got = 0;
+    while(got < size && pipe->tail != pipe->head) {
+        data[got++] = pipe->data[pipe->tail++ & (LINK_LOOPBACK_SIZE - 1)];
+    }
+    return got;
+}
+
+void link_loopback_init(LinkLoopback* loopback) {
+    memset(loopback, 0, sizeof(LinkLoopback));
+    loopback->ends[0] = (LinkLoopbackEnd){&loopback->pipes[0], &loopback->pipes[1]};
+    loopback->ends[1] = (LinkLoopbackEnd){&loopback->pipes[1], &loopback->pipes[0]};
+}
+
+LinkTransport link_loopback_transport(LinkLoopback* loopback, int end) {
+    return (LinkTransport){loopback_send, loopback_receive, &loopback->ends[end & 1]};
+}
@@ -0,0 +1,107 @@
+// link.h - Lockstep two-player battles: both sides resolve, only moves travel
+#ifndef LINK_H
+#define LINK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "battle.h"
+
+// Every message is one fixed size packet:
+//   u8 type, u8 turn, u8 arg0, u8 arg1, u32 value (little endian)
+// Hello:  arg0 species, arg1 level, value seed half
+// Action: arg0 move slot, value hash of the battle before the turn
+// Desync: value our hash, sent when the peer's hash did not match so both stop
+#define LINK_PACKET_SIZE 8
+
+typedef enum {
+    LinkPacketHello = 0x4C,
+    LinkPacketAction = 0x41,
+    LinkPacketDesync = 0x44,
+} LinkPacketType;
+
+// Byte pipe to the other device. Both calls must return at once: send
+// either takes all bytes or none, receive copies what already arrived.
+typedef struct {
+    bool (*send)(void* ctx, const uint8_t* data, size_t size);
+    size_t (*receive)(void* ctx, uint8_t* data, size_t size);
+    void* ctx;
+} LinkTransport;
+
+// The host's Pokemon moves first on equal speed, otherwise both sides are alike
+typedef enum {
+    LinkRoleHost,
+    LinkRoleGuest,
+} LinkRole;
+
+typedef enum {
+    LinkStateHandshake, // Waiting for the peer's Pokemon and seed half
+    LinkStateChoose,    // Waiting for the local move
+    LinkStateWaiting,   // Local move sent, waiting for the peer's
+    LinkStateTurnDone,  // Turn resolved, events are ready, next move can be chosen
+    LinkStateOver,      // A Pokemon fainted
+    LinkStateDesync,    // State hashes differ, detected here or reported by the peer
+    LinkStateError,     // Malformed packet or the transport failed
+} LinkState;
+
+typedef struct {
+    LinkTransport transport;
+    uint8_t role;  // LinkRole
+    uint8_t state; // LinkState
+    uint8_t turn;
+    int8_t local_move;  // -1 until chosen for this turn
+    int8_t remote_move; // -1 until received for this turn
+    uint32_t nonce;     // Our seed half
+    uint32_t remote_hash; // Peer's state hash from its last move or desync report
+    BattleRng rng;
+    Pokemon local;
+    Pokemon remote;
+    BattleEventQueue events; // Last turn, BattleSidePlayer is the local side
+    uint8_t rx[LINK_PACKET_SIZE];
+    uint8_t rx_len;
+    // Statistics
+    uint32_t bytes_sent;
+    uint32_t bytes_received;
+    uint32_t sent_at;         // Cycle stamp of our last move
+    uint32_t wait_total;      // Cycles from sending our move to resolving the turn
+    uint32_t wait_max;
+} LinkBattle;
+
+// Reset the battle and send our Pokemon and seed half to the peer
+void link_battle_start(LinkBattle* link, LinkTransport transport, LinkRole role, PokemonSpecies species, int level, uint32_t nonce);
+
+// Read whatever the transport has: finishes the handshake, takes the
+// peer's move and resolves the turn once both moves are in. Never waits.
+LinkState link_battle_poll(LinkBattle* link);
+
+// Send our move for the current turn, false if it is not our turn to
+// choose or the slot is empty
+bool link_battle_choose(LinkBattle* link, int slot);
+
+// Hash of everything both sides must agree on: turn, rolls and both Pokemon
+uint32_t link_battle_hash(const LinkBattle* link);
+
+// In-memory pipe between two LinkBattles on the same thread, e.g. two
+// headless instances playing against each other. End 0 talks to end 1.
+#define LINK_LOOPBACK_SIZE 64 // Bytes in flight per direction, power of two
+
+typedef struct {
+    uint8_t data[LINK_LOOPBACK_SIZE];
+    uint32_t head;
+    uint32_t tail;
+} LinkLoopbackPipe;
+
+typedef struct {
+    LinkLoopbackPipe* tx;
+    LinkLoopbackPipe* rx;
+} LinkLoopbackEnd;
+
+typedef struct {
+    LinkLoopbackPipe pipes[2];
+    LinkLoopbackEnd ends[2];
+} LinkLoopback;
+
+void link_loopback_init(LinkLoopback* loopback);
+LinkTransport link_loopback_transport(LinkLoopback* loopback, int end);
+
+#endif // LINK_H
@@ -0,0 +1,26 @@
+#include "map_bits.h"
+#include <string.h>
+
+void map_bits_clear(MapBits* bits) {
+    memset(bits, 0, sizeof(MapBits));
+}
+
+void map_bits_set_solid(MapBits* bits, int x, int y, bool solid) {
+    if((unsigned)x >= MAP_WIDTH || (unsigned)y >= MAP_HEIGHT) return;
+
+    if(solid) {
+        bits->solid_rows[y] |= 1u << x;
+        bits->solid_cols[x] |= 1u << y;
+    } else {
+        bits->solid_rows[y] &= ~(1u << x);
+        bits->solid_cols[x] &= ~(1u << y);
+    }
+}
+
+void map_bits_set_zone(MapBits* bits, int x, int y, uint8_t zone) {
+    if((unsigned)x >= MAP_WIDTH || (unsigned)y >= MAP_HEIGHT) return;
+
+    uint32_t* word = &bits->zone_rows[y][x / MAP_BITS_ZONES_PER_WORD];
+    int shift = (x % MAP_BITS_ZONES_PER_WORD) * 4;
+    *word = (*word & ~(0xFu << shift)) | ((uint32_t)(zone & 0xF) << shift);
+}
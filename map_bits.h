@@ -0,0 +1,72 @@
+// map_bits.h - Packed per-map collision and encounter zone bitsets
+#ifndef MAP_BITS_H
+#define MAP_BITS_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "maps.h"
+
+#define MAP_BITS_ZONE_NONE      0   // Cell never triggers encounters
+#define MAP_BITS_ZONE_COUNT     16  // Zone IDs are 4 bits wide
+#define MAP_BITS_ZONES_PER_WORD 8
+#define MAP_BITS_ZONE_WORDS     ((MAP_WIDTH + MAP_BITS_ZONES_PER_WORD - 1) / MAP_BITS_ZONES_PER_WORD)
+
+_Static_assert(MAP_WIDTH <= 32 && MAP_HEIGHT <= 32, "A map row or column must fit in one 32 bit word");
+
+// Solidity is stored twice so both horizontal and vertical scans of up to
+// 32 cells are a single load and mask.
+typedef struct {
+    uint32_t solid_rows[MAP_HEIGHT];  // Bit x of word y set if cell (x, y) is solid
+    uint32_t solid_cols[MAP_WIDTH];   // Bit y of word x, the same data transposed
+    uint32_t zone_rows[MAP_HEIGHT][MAP_BITS_ZONE_WORDS]; // Encounter zone ID, a nibble per cell
+} MapBits;
+
+// Reset to open cells without encounters
+void map_bits_clear(MapBits* bits);
+
+void map_bits_set_solid(MapBits* bits, int x, int y, bool solid);
+void map_bits_set_zone(MapBits* bits, int x, int y, uint8_t zone);
+
+// Mask with bits lo..hi (inclusive) set, lo <= hi < 32
+static inline uint32_t map_bits_span_mask(int lo, int hi) {
+    return (0xFFFFFFFFu >> (31 - hi)) & (0xFFFFFFFFu << lo);
+}
+
+// Cells outside the map count as solid
+static inline bool map_bits_is_solid(const MapBits* bits, int x, int y) {
+    if((unsigned)x >= MAP_WIDTH || (unsigned)y >= MAP_HEIGHT) return true;
+    return (bits->solid_rows[y] >> x) & 1;
+}
+
+// Solidity of a whole row, bit x for column x
+static inline uint32_t map_bits_row(const MapBits* bits, int y) {
+    return bits->solid_rows[y];
+}
+
+// Solidity of a whole column, bit y for row y
+static inline uint32_t map_bits_column(const MapBits* bits, int x) {
+    return bits->solid_cols[x];
+}
+
+// True if no cell from x0 to x1 (inclusive, any order) on row y is solid
+static inline bool map_bits_row_clear(const MapBits* bits, int y, int x0, int x1) {
+    int lo = x0 < x1 ? x0 : x1;
+    int hi = x0 < x1 ? x1 : x0;
+    return (bits->solid_rows[y] & map_bits_span_mask(lo, hi)) == 0;
+}
+
+// True if no cell from y0 to y1 (inclusive, any order) in column x is solid
+static inline bool map_bits_column_clear(const MapBits* bits, int x, int y0, int y1) {
+    int lo = y0 < y1 ? y0 : y1;
+    int hi = y0 < y1 ? y1 : y0;
+    return (bits->solid_cols[x] & map_bits_span_mask(lo, hi)) == 0;
+}
+
+// Encounter zone of a cell, MAP_BITS_ZONE_NONE outside the map
+static inline uint8_t map_bits_zone(const MapBits* bits, int x, int y) {
+    if((unsigned)x >= MAP_WIDTH || (unsigned)y >= MAP_HEIGHT) return MAP_BITS_ZONE_NONE;
+    uint32_t word = bits->zone_rows[y][x / MAP_BITS_ZONES_PER_WORD];
+    return (word >> ((x % MAP_BITS_ZONES_PER_WORD) * 4)) & 0xF;
+}
+
+#endif // MAP_BITS_H
@@ -1,3 +1,49 @@
-
 #include "maps.h"
+#include <stddef.h>
+
+// Exit tables, each one sorted by tile key so lookups can binary search
+static const MapExit route_1_exits[] = {
+    {.tile = MAP_TILE_KEY(4, MAP_HEIGHT - 2), .destination_map_index = 1, .destination_x = 2, .destination_y = MAP_HEIGHT / 2},
+};
+
+static const MapExit pallet_town_exits[] = {
+    {.tile = MAP_TILE_KEY(4, 1), .destination_map_index = 0, .destination_x = 4, .destination_y = MAP_HEIGHT - 3},
+};
+
+const MapWarpTable map_warps[MAX_MAPS] = {
+    {route_1_exits, sizeof(route_1_exits) / sizeof(route_1_exits[0])},
+    {pallet_town_exits, sizeof(pallet_town_exits) / sizeof(pallet_town_exits[0])},
+};
+
+const MapExit* map_find_exit(int map_index, int tile_x, int tile_y) {
+    const MapWarpTable* table = &map_warps[map_index];
+    uint16_t key = MAP_TILE_KEY(tile_x, tile_y);
+    int low = 0;
+    int high = table->count - 1;
+
+    while(low <= high) {
+        int mid = (low + high) / 2;
+        uint16_t mid_key = table->exits[mid].tile;
+        if(mid_key == key) return &table->exits[mid];
+        if(mid_key < key) {
+            low = mid + 1;
+        } else {
+            high = mid - 1;
+        }
+    }
+    return NULL;
+}
+
+// Scripts and flags refer to scripts/map_<n>.fms
+static const NpcSpawn route_1_npcs[] = {
+    {.x = 12, .y = 5, .direction = 3, .vision = 4, .party = 0, .script = 1, .defeat_flag = 2},
+};
+
+static const NpcSpawn pallet_town_npcs[] = {
+    {.x = 8, .y = 8, .direction = 3, .vision = 0, .script = 1},
+};
 
+const MapNpcTable map_npcs[MAX_MAPS] = {
+    {route_1_npcs, sizeof(route_1_npcs) / sizeof(route_1_npcs[0])},
+    {pallet_town_npcs, sizeof(pallet_town_npcs) / sizeof(pallet_town_npcs[0])},
+};
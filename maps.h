@@ -1,14 +1,52 @@
+// maps.h - Map dimensions, exit (warp) tables and the starter tile layout
+#ifndef MAPS_H
+#define MAPS_H
+
+#include <stdint.h>
 
 #define MAX_MAPS 5
 #define MAP_HEIGHT 20
 #define MAP_WIDTH 20
 
+// Pack a tile coordinate into a sort key, ordered row by row
+#define MAP_TILE_KEY(x, y) ((uint16_t)(((y) << 8) | (x)))
+
 typedef struct {
+    uint16_t tile;              // MAP_TILE_KEY of the exit tile on its own map
     int destination_map_index;  // Which map this exit leads to
     int destination_x;          // Where the player appears on the new map
     int destination_y;
 } MapExit;
 
+// Exits of one map, sorted by tile key
+typedef struct {
+    const MapExit* exits;
+    int count;
+} MapWarpTable;
+
+extern const MapWarpTable map_warps[MAX_MAPS];
+
+// An overworld character placed on a map
+typedef struct {
+    uint8_t x;
+    uint8_t y;
+    uint8_t direction;   // 1: up, 2: right, 3: down, 4: left
+    uint8_t vision;      // Tiles a trainer sees ahead, 0 for NPCs that never challenge
+    uint8_t party;       // Index into trainer_parties when vision > 0
+    uint8_t script;      // Map script run when the player talks to it
+    uint8_t defeat_flag; // Script flag set once the trainer has been beaten
+} NpcSpawn;
+
+typedef struct {
+    const NpcSpawn* npcs;
+    int count;
+} MapNpcTable;
+
+extern const MapNpcTable map_npcs[MAX_MAPS];
+
+// Exit on the given tile of a map, NULL if the tile is not a warp
+const MapExit* map_find_exit(int map_index, int tile_x, int tile_y);
+
 
 // Pointer to current map (shortcut for readability)
 #define CURRENT_MAP (&maps[current_map_index])
@@ -37,3 +75,5 @@ static const unsigned char tile_map[] = {
     /* Row 18 */1,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,1,
     /* Row 19 */1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1
 };
+
+#endif // MAPS_H
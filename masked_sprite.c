@@ -0,0 +1,60 @@
+#include "masked_sprite.h"
+
+#define SCREEN_WIDTH  128
+#define SCREEN_PAGES  8
+#define SCREEN_BYTES  (SCREEN_WIDTH * SCREEN_PAGES)
+
+// Per pixel path for a canvas whose buffer is not the 128x64 page layout
+static void draw_dots(Canvas* canvas, const MaskedSprite* sprite, int x, int y) {
+    for(int sy = 0; sy < sprite->height; sy++) {
+        for(int sx = 0; sx < sprite->width; sx++) {
+            const uint8_t* src = masked_sprite_column(sprite, sy / 8, sx);
+            uint8_t bit = 1 << (sy % 8);
+            if(!(src[1] & bit)) continue;
+            canvas_set_color(canvas, (src[0] & bit) ? ColorBlack : ColorWhite);
+            canvas_draw_dot(canvas, x + sx, y + sy);
+        }
+    }
+    canvas_set_color(canvas, ColorBlack);
+}
+
+void masked_sprite_draw(Canvas* canvas, const MaskedSprite* sprite, int x, int y) {
+    if(canvas_get_buffer_size(canvas) != SCREEN_BYTES) {
+        draw_dots(canvas, sprite, x, y);
+        return;
+    }
+
+    int first = x < 0 ? -x : 0;
+    int last = x + sprite->width > SCREEN_WIDTH ? SCREEN_WIDTH - x : sprite->width;
+    if(first >= last) return;
+
+    // A sprite page lands on two screen pages unless y is page aligned
+    int top_page = y >= 0 ? y / 8 : -((7 - y) / 8);
+    int shift = y - top_page * 8;
+    int pages = (sprite->height + 7) / 8;
+    uint8_t* screen = canvas_get_buffer(canvas);
+
+    for(int page = 0; page < pages; page++) {
+        int upper_page = top_page + page;
+        int lower_page = upper_page + 1;
+        uint8_t* upper = upper_page >= 0 && upper_page < SCREEN_PAGES ? screen + upper_page * SCREEN_WIDTH + x : NULL;
+        uint8_t* lower = shift && lower_page >= 0 && lower_page < SCREEN_PAGES ? screen + lower_page * SCREEN_WIDTH + x : NULL;
+        if(upper == NULL && lower == NULL) continue;
+
+        // Each cell is looked up once, then its columns are walked in order
+        for(int cell_x = first / MASKED_SPRITE_CELL; cell_x * MASKED_SPRITE_CELL < last; cell_x++) {
+            int cell_start = cell_x * MASKED_SPRITE_CELL;
+            int start = cell_start > first ? cell_start : first;
+            int end = cell_start + MASKED_SPRITE_CELL < last ? cell_start + MASKED_SPRITE_CELL : last;
+            int step;
+            const uint8_t* src = masked_sprite_cell(sprite, page, cell_x, &step) + (start - cell_start) * step;
+
+            for(int i = start; i < end; i++, src += step) {
+                uint8_t bits = src[0];
+                uint8_t mask = src[1];
+                if(upper) upper[i] = (upper[i] & ~(uint8_t)(mask << shift)) | (uint8_t)(bits << shift);
+                if(lower) lower[i] = (lower[i] & ~(mask >> (8 - shift))) | (bits >> (8 - shift));
+            }
+        }
+    }
+}
@@ -0,0 +1,49 @@
+// masked_sprite.h - 1 bpp sprites with a transparency mask, in display page format
+#ifndef MASKED_SPRITE_H
+#define MASKED_SPRITE_H
+
+#include <stdint.h>
+#include <gui/gui.h>
+
+#define MASKED_SPRITE_CELL       8      // Cells are 8x8 pixels, one display page tall
+#define MASKED_SPRITE_CELL_BYTES 16     // 8 columns of (bits, mask)
+#define MASKED_SPRITE_MIRRORED   0x8000 // Cell number flag: use the cell flipped left to right
+
+// Sprites are built from 8x8 cells shared through a pool, see
+// tools/gen_assets.py. A cell holds one (bits, mask) byte pair per column
+// with the top row in bit 0; the layout of the display buffer, so a blit
+// is a whole-byte (dst & ~mask) | bits per column.
+typedef struct {
+    uint8_t width;
+    uint8_t height;
+    const uint16_t* cells; // Pool cell numbers, (width + 7) / 8 per page, page by page
+    const uint8_t* pool;
+} MaskedSprite;
+
+// Column 0 of cell cell_x in a page of the sprite, and in step the byte
+// distance to the next column: negative for a mirrored cell, which is
+// walked from its last stored column back
+static inline const uint8_t* masked_sprite_cell(const MaskedSprite* sprite, int page, int cell_x, int* step) {
+    uint16_t cell = sprite->cells[page * ((sprite->width + MASKED_SPRITE_CELL - 1) / MASKED_SPRITE_CELL) + cell_x];
+    const uint8_t* data = sprite->pool + (cell & ~MASKED_SPRITE_MIRRORED) * MASKED_SPRITE_CELL_BYTES;
+    if(cell & MASKED_SPRITE_MIRRORED) {
+        *step = -2;
+        return data + (MASKED_SPRITE_CELL - 1) * 2;
+    }
+    *step = 2;
+    return data;
+}
+
+// (bits, mask) byte pair of column x in a page of the sprite. Loops over
+// columns should resolve each cell once with masked_sprite_cell instead.
+static inline const uint8_t* masked_sprite_column(const MaskedSprite* sprite, int page, int x) {
+    int step;
+    const uint8_t* cell = masked_sprite_cell(sprite, page, x / MASKED_SPRITE_CELL, &step);
+    return cell + (x % MASKED_SPRITE_CELL) * step;
+}
+
+// Draw at any position, clipped to the screen. Opaque white pixels clear
+// the background, transparent ones leave it alone.
+void masked_sprite_draw(Canvas* canvas, const MaskedSprite* sprite, int x, int y);
+
+#endif // MASKED_SPRITE_H
@@ -0,0 +1,117 @@
+#include "pathfind.h"
+#include <stdlib.h>
+#include <string.h>
+
+static const int8_t dir_dx[5] = {0, 0, 1, 0, -1};
+static const int8_t dir_dy[5] = {0, -1, 0, 1, 0};
+
+static inline int heuristic(int cell, int tx, int ty) {
+    return abs(cell % MAP_WIDTH - tx) + abs(cell / MAP_WIDTH - ty);
+}
+
+// Move entry up from index i to where its f belongs
+static void heap_sift_up(PathScratch* scratch, int i, PathOpenEntry entry) {
+    while(i > 0) {
+        int parent = (i - 1) / 2;
+        if(scratch->open[parent].f <= entry.f) break;
+        scratch->open[i] = scratch->open[parent];
+        scratch->open_pos[scratch->open[i].cell] = i;
+        i = parent;
+    }
+    scratch->open[i] = entry;
+    scratch->open_pos[entry.cell] = i;
+}
+
+static void heap_push(PathScratch* scratch, uint16_t cell, uint16_t f) {
+    heap_sift_up(scratch, scratch->open_count++, (PathOpenEntry){cell, f});
+}
+
+// A cell already in the heap got a cheaper route: lower its key in place
+static void heap_decrease(PathScratch* scratch, uint16_t cell, uint16_t f) {
+    heap_sift_up(scratch, scratch->open_pos[cell], (PathOpenEntry){cell, f});
+}
+
+static uint16_t heap_pop(PathScratch* scratch) {
+    uint16_t top = scratch->open[0].cell;
+    PathOpenEntry last = scratch->open[--scratch->open_count];
+    int count = scratch->open_count;
+    int i = 0;
+
+    while(true) {
+        int child = i * 2 + 1;
+        if(child >= count) break;
+        if(child + 1 < count && scratch->open[child + 1].f < scratch->open[child].f) child++;
+        if(scratch->open[child].f >= last.f) break;
+        scratch->open[i] = scratch->open[child];
+        scratch->open_pos[scratch->open[i].cell] = i;
+        i = child;
+    }
+    if(count > 0) {
+        scratch->open[i] = last;
+        scratch->open_pos[last.cell] = i;
+    }
+    return top;
+}
+
+int pathfind(PathScratch* scratch, const MapBits* bits, const uint32_t* blocked_rows, int sx, int sy, int tx, int ty, uint8_t* path, int max_steps) {
+    if(map_bits_is_solid(bits, tx, ty) || map_bits_is_solid(bits, sx, sy)) return -1;
+
+    memset(scratch->came_from, 0, sizeof(scratch->came_from));
+    memset(scratch->closed, 0, sizeof(scratch->closed));
+    scratch->open_count = 0;
+    scratch->expanded = 0;
+
+    int start = sy * MAP_WIDTH + sx;
+    int target = ty * MAP_WIDTH + tx;
+    scratch->cost[start] = 0;
+    scratch->came_from[start] = 0xFF; // Marks the start as visited
+    heap_push(scratch, start, heuristic(start, tx, ty));
+
+    while(scratch->open_count > 0) {
+        int cell = heap_pop(scratch);
+        int x = cell % MAP_WIDTH;
+        int y = cell / MAP_WIDTH;
+
+        scratch->closed[y] |= 1u << x;
+        scratch->expanded++;
+
+        if(cell == target) break;
+        if(scratch->cost[cell] >= max_steps) continue;
+
+        for(int dir = 1; dir <= 4; dir++) {
+            int nx = x + dir_dx[dir];
+            int ny = y + dir_dy[dir];
+            if(map_bits_is_solid(bits, nx, ny)) continue;
+            if(blocked_rows && (blocked_rows[ny] & (1u << nx)) && !(nx == tx && ny == ty)) continue;
+            if(scratch->closed[ny] & (1u << nx)) continue;
+
+            int next = ny * MAP_WIDTH + nx;
+            uint16_t next_cost = scratch->cost[cell] + 1;
+            // Visited but not closed means the cell is waiting in the heap
+            bool queued = scratch->came_from[next] != 0;
+            if(queued && scratch->cost[next] <= next_cost) continue;
+
+            scratch->cost[next] = next_cost;
+            scratch->came_from[next] = dir;
+            uint16_t f = next_cost + heuristic(next, tx, ty);
+            if(queued) {
+                heap_decrease(scratch, next, f);
+            } else {
+                heap_push(scratch, next, f);
+            }
+        }
+    }
+
+    if(!(scratch->closed[ty] & (1u << tx))) return -1;
+
+    // Walk back from the target, then the directions are already in order
+    int steps = scratch->cost[target];
+    if(steps > max_steps) return -1;
+    int cell = target;
+    for(int i = steps - 1; i >= 0; i--) {
+        int dir = scratch->came_from[cell];
+        path[i] = dir;
+        cell -= dir_dy[dir] * MAP_WIDTH + dir_dx[dir];
+    }
+    return steps;
+}
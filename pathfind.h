@@ -0,0 +1,37 @@
+// pathfind.h - A* over a map's solidity bitset with preallocated scratch space
+#ifndef PATHFIND_H
+#define PATHFIND_H
+
+#include <stdint.h>
+#include "maps.h"
+#include "map_bits.h"
+
+#define PATHFIND_CELLS (MAP_WIDTH * MAP_HEIGHT)
+
+// Open list entry, the f-score (cost + heuristic) is fixed while it sits in the heap
+typedef struct {
+    uint16_t cell;
+    uint16_t f;
+} PathOpenEntry;
+
+// Everything a search needs, allocated once so no heap use happens during play
+typedef struct {
+    uint16_t cost[PATHFIND_CELLS];   // Best known steps from the start
+    uint8_t came_from[PATHFIND_CELLS]; // Direction taken into the cell, 0 if unvisited
+    // Binary min-heap by f. A cell is in it at most once (a cheaper route
+    // lowers its entry in place), so it can never overflow.
+    PathOpenEntry open[PATHFIND_CELLS];
+    uint16_t open_pos[PATHFIND_CELLS]; // Heap index of each cell in the open list
+    uint16_t open_count;
+    uint32_t closed[MAP_HEIGHT];     // Bit x of word y set once a cell is expanded
+    uint16_t expanded;               // Cells expanded by the last search
+} PathScratch;
+
+// Find a shortest path from (sx, sy) to (tx, ty). Cells that are solid in
+// bits or have their bit set in blocked_rows (may be NULL) are avoided, the
+// target itself must be open. Writes directions (1: up, 2: right, 3: down,
+// 4: left) to path and returns the step count, or -1 if there is no path of
+// at most max_steps.
+int pathfind(PathScratch* scratch, const MapBits* bits, const uint32_t* blocked_rows, int sx, int sy, int tx, int ty, uint8_t* path, int max_steps);
+
+#endif // PATHFIND_H
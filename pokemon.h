@@ -2,6 +2,9 @@
 #ifndef POKEMON_H
 #define POKEMON_H
 
+#include <stdint.h>
+#include "masked_sprite.h"
+
 // Define Pokemon species
 typedef enum {
     POKEMON_BULBASAUR,
@@ -36,7 +39,7 @@ typedef enum {
 
 // Move structure
 typedef struct {
-    const char* name;
+    uint16_t name; // TextId
     MoveType type;
     int power;
     int accuracy;
@@ -47,9 +50,10 @@ typedef struct {
 // Define all possible moves
 extern const Move all_moves[];
 
-// Pokemon can have up to 4 moves
+// Pokemon can have up to 4 moves, empty slots are NULL. Moves point into
+// all_moves so a Pokemon stays small enough to pass around freely.
 typedef struct {
-    const char* name;
+    uint16_t name; // TextId
     PokemonSpecies species;
     int level;
     int max_hp;
@@ -57,23 +61,58 @@ typedef struct {
     int attack;
     int defense;
     int speed;
-    const unsigned char* front_sprite;
-    const unsigned char* back_sprite;
-    Move moves[4];
+    MoveEffect status;    // EFFECT_NONE while healthy
+    uint8_t status_turns; // Sleeping turns left, counting the one it wakes on
+    const MaskedSprite* front_sprite;
+    const MaskedSprite* back_sprite;
+    const Move* moves[4];
 } Pokemon;
 
 
+// Pokemon a trainer battles with, in send-out order
+#define TRAINER_PARTY_MAX 6
+
+typedef struct {
+    uint16_t name; // TextId
+    int count;
+    PokemonSpecies species[TRAINER_PARTY_MAX];
+    int levels[TRAINER_PARTY_MAX];
+} TrainerParty;
+
+// Indexed by NpcSpawn.party
+extern const TrainerParty trainer_parties[];
+
 // Default move sets per Pokemon species
 extern const Move* default_moves[POKEMON_COUNT][4];
 
-// Initialize a new Pokemon
-Pokemon create_pokemon(PokemonSpecies species, int level);
+// Initialize a new Pokemon in place
+void create_pokemon(Pokemon* pokemon, PokemonSpecies species, int level);
+
+// Back to healthy, a status lasts until the battle ends
+static inline void pokemon_clear_status(Pokemon* pokemon) {
+    pokemon->status = EFFECT_NONE;
+    pokemon->status_turns = 0;
+}
+
+// Exact damage spread of a move over all random rolls (85% to 100%)
+#define DAMAGE_ROLLS 16
 
 // Calculate damage for a move
-int calculate_damage(Move move, Pokemon attacker, Pokemon defender);
+int calculate_damage(const Move* move, const Pokemon* attacker, const Pokemon* defender);
 
+// Damage for a given roll, 0..DAMAGE_ROLLS-1 from 85% up to 100%
+int calculate_damage_roll(const Move* move, const Pokemon* attacker, const Pokemon* defender, int roll);
 
-extern const unsigned char bulbasaur[];
+typedef struct {
+    int min_damage;
+    int max_damage;
+    uint8_t ko_rolls;   // Rolls out of DAMAGE_ROLLS that knock out in one hit
+    uint16_t ko2_rolls; // Roll pairs out of DAMAGE_ROLLS^2 that knock out in two hits
+} DamageOutcome;
+
+// Outcomes of each of attacker's move slots against defender's current HP,
+// ignoring accuracy. Status moves and empty slots come out all zero.
+void damage_outcomes(const Pokemon* attacker, const Pokemon* defender, DamageOutcome out[4]);
 
 
 
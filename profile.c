@@ -0,0 +1,107 @@
+// The HUD's own drawing is not counted
+#define PROFILE_NO_CANVAS_COUNT
+#include "profile.h"
+
+#ifdef FLIPPER_MON_PROFILE
+
+#include <furi.h>
+#include <stdio.h>
+#include <string.h>
+
+#define PROFILE_TOP_COUNT 3 // Sections listed on the HUD
+
+Profiler profiler;
+
+static const char* const section_names[ProfileSectionCount] = {"move", "bat_ui", "draw_map", "draw_bat", "frame"};
+
+void profile_init(void) {
+    memset(&profiler, 0, sizeof(Profiler));
+    profiler.window_start = furi_get_tick();
+    profiler.min_free_heap = memmgr_get_free_heap();
+}
+
+void profile_record(ProfileSection section, uint32_t cycles) {
+    ProfileTimer* timer = &profiler.window[section];
+    timer->cycles += cycles;
+    timer->calls++;
+    if(cycles > timer->worst) timer->worst = cycles;
+}
+
+// One line per second, grep the log for "PROFILE" to collect a run
+static void profile_log(void) {
+    FURI_LOG_I("Profile", "PROFILE fps=%lu draws/frame=%lu queue=%lu heap=%u min_heap=%u",
+               profiler.fps, profiler.canvas_calls_per_frame, profiler.max_queue_depth,
+               (unsigned)profiler.free_heap, (unsigned)profiler.min_free_heap);
+    for(int i = 0; i < ProfileSectionCount; i++) {
+        if(profiler.total_us[i] == 0) continue;
+        FURI_LOG_I("Profile", "PROFILE %s avg_us=%lu worst_us=%lu total_us=%lu",
+                   section_names[i], profiler.avg_us[i], profiler.worst_us[i], profiler.total_us[i]);
+    }
+}
+
+void profile_frame_done(void) {
+    profiler.frames++;
+
+    uint32_t now = furi_get_tick();
+    if(now - profiler.window_start < furi_kernel_get_tick_frequency()) return;
+
+    uint32_t cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+    for(int i = 0; i < ProfileSectionCount; i++) {
+        ProfileTimer* timer = &profiler.window[i];
+        profiler.total_us[i] = timer->cycles / cycles_per_us;
+        profiler.avg_us[i] = timer->calls ? profiler.total_us[i] / timer->calls : 0;
+        profiler.worst_us[i] = timer->worst / cycles_per_us;
+    }
+    profiler.fps = profiler.frames;
+    profiler.canvas_calls_per_frame = profiler.canvas_calls / profiler.frames;
+    profiler.max_queue_depth = profiler.queue_depth;
+    profiler.free_heap = memmgr_get_free_heap();
+    if(profiler.free_heap < profiler.min_free_heap) profiler.min_free_heap = profiler.free_heap;
+
+    memset(profiler.window, 0, sizeof(profiler.window));
+    profiler.frames = 0;
+    profiler.canvas_calls = 0;
+    profiler.queue_depth = 0;
+    profiler.window_start = now;
+
+    profile_log();
+}
+
+void profile_draw_overlay(Canvas* canvas) {
+    char line[32];
+
+    // Most expensive sections of the last window, the frame itself is on the first line
+    int top[PROFILE_TOP_COUNT];
+    int top_count = 0;
+    uint32_t taken = 0;
+    while(top_count < PROFILE_TOP_COUNT) {
+        int best = -1;
+        for(int i = 0; i < ProfileFrame; i++) {
+            if((taken >> i) & 1 || profiler.total_us[i] == 0) continue;
+            if(best < 0 || profiler.total_us[i] > profiler.total_us[best]) best = i;
+        }
+        if(best < 0) break;
+        taken |= 1u << best;
+        top[top_count++] = best;
+    }
+
+    int height = 9 * (3 + top_count) + 2;
+    canvas_set_color(canvas, ColorWhite);
+    canvas_draw_box(canvas, 0, 0, 76, height);
+    canvas_set_color(canvas, ColorBlack);
+    canvas_draw_frame(canvas, 0, 0, 76, height);
+    canvas_set_font(canvas, FontSecondary);
+
+    snprintf(line, sizeof(line), "%lufps worst %lums", profiler.fps, profiler.worst_us[ProfileFrame] / 1000);
+    canvas_draw_str(canvas, 2, 9, line);
+    snprintf(line, sizeof(line), "draw %lu q %lu", profiler.canvas_calls_per_frame, profiler.max_queue_depth);
+    canvas_draw_str(canvas, 2, 18, line);
+    snprintf(line, sizeof(line), "heap %uk", (unsigned)(profiler.free_heap / 1024));
+    canvas_draw_str(canvas, 2, 27, line);
+    for(int i = 0; i < top_count; i++) {
+        snprintf(line, sizeof(line), "%s %luus", section_names[top[i]], profiler.total_us[top[i]]);
+        canvas_draw_str(canvas, 2, 36 + i * 9, line);
+    }
+}
+
+#endif // FLIPPER_MON_PROFILE
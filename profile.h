@@ -0,0 +1,106 @@
+// profile.h - Optional timing counters and on-screen HUD.
+// Build with -DFLIPPER_MON_PROFILE (e.g. cdefines in application.fam) to
+// enable; otherwise every macro below expands to nothing.
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+// Benchmarks report canvas calls per op, which needs the draw counters
+#if defined(FLIPPER_MON_BENCH) && !defined(FLIPPER_MON_PROFILE)
+#define FLIPPER_MON_PROFILE
+#endif
+
+typedef enum {
+    ProfileMovement,        // handle_movement
+    ProfileBattleUi,        // update_battle_ui
+    ProfileDrawExploration, // draw_exploration_scene
+    ProfileDrawBattle,      // draw_battle_scene
+    ProfileFrame,           // Whole draw callback
+    ProfileSectionCount
+} ProfileSection;
+
+#ifdef FLIPPER_MON_PROFILE
+
+#include <furi_hal.h>
+#include <gui/gui.h>
+
+typedef struct {
+    uint32_t cycles; // Sum over the current window
+    uint32_t worst;
+    uint32_t calls;
+} ProfileTimer;
+
+// Counters are bumped from both the game and the GUI thread without locking,
+// an occasionally torn value is fine for a debug HUD.
+typedef struct {
+    ProfileTimer window[ProfileSectionCount]; // Accumulating, rolled once a second
+    uint32_t avg_us[ProfileSectionCount];     // Results of the last full window
+    uint32_t worst_us[ProfileSectionCount];
+    uint32_t total_us[ProfileSectionCount];   // Time spent per second
+    uint32_t canvas_calls;                    // Draw calls in the current window
+    uint32_t canvas_calls_per_frame;
+    uint32_t frames;                          // Frames drawn in the current window
+    uint32_t fps;
+    uint32_t queue_depth;                     // Deepest event queue seen in the window
+    uint32_t max_queue_depth;
+    size_t free_heap;
+    size_t min_free_heap;
+    uint32_t window_start;
+    bool overlay;
+} Profiler;
+
+extern Profiler profiler;
+
+typedef struct {
+    ProfileSection section;
+    uint32_t start;
+} ProfileScope;
+
+static inline uint32_t profile_cycles(void) {
+    return DWT->CYCCNT;
+}
+
+void profile_init(void);
+void profile_record(ProfileSection section, uint32_t cycles);
+
+// Called once per drawn frame, rolls the window and logs it every second
+void profile_frame_done(void);
+void profile_draw_overlay(Canvas* canvas);
+
+static inline void profile_scope_end(ProfileScope* scope) {
+    profile_record(scope->section, profile_cycles() - scope->start);
+}
+
+// Times the rest of the enclosing block, early returns included
+#define PROFILE_SCOPE(section) \
+    ProfileScope profile_scope_ __attribute__((cleanup(profile_scope_end))) = {(section), profile_cycles()}
+#define PROFILE_QUEUE_DEPTH(depth) \
+    do { uint32_t d_ = (depth); if(d_ > profiler.queue_depth) profiler.queue_depth = d_; } while(0)
+#define PROFILE_TOGGLE_OVERLAY() (profiler.overlay = !profiler.overlay)
+#define PROFILE_DRAW_OVERLAY(canvas) do { profile_frame_done(); if(profiler.overlay) profile_draw_overlay(canvas); } while(0)
+#define PROFILE_INIT() profile_init()
+
+// Count canvas draw calls in every file that includes this header
+#ifndef PROFILE_NO_CANVAS_COUNT
+#define canvas_draw_str(...)   (profiler.canvas_calls++, canvas_draw_str(__VA_ARGS__))
+#define canvas_draw_xbm(...)   (profiler.canvas_calls++, canvas_draw_xbm(__VA_ARGS__))
+#define canvas_draw_box(...)   (profiler.canvas_calls++, canvas_draw_box(__VA_ARGS__))
+#define canvas_draw_frame(...) (profiler.canvas_calls++, canvas_draw_frame(__VA_ARGS__))
+#define canvas_draw_line(...)  (profiler.canvas_calls++, canvas_draw_line(__VA_ARGS__))
+#define canvas_draw_dot(...)   (profiler.canvas_calls++, canvas_draw_dot(__VA_ARGS__))
+#endif
+
+#else
+
+#define PROFILE_SCOPE(section) ((void)0)
+#define PROFILE_QUEUE_DEPTH(depth) ((void)0)
+#define PROFILE_TOGGLE_OVERLAY() ((void)0)
+#define PROFILE_DRAW_OVERLAY(canvas) ((void)0)
+#define PROFILE_INIT() ((void)0)
+
+#endif // FLIPPER_MON_PROFILE
+
+#endif // PROFILE_H
@@ -0,0 +1,119 @@
+#include "scheduler.h"
+#include <furi.h>
+#include <furi_hal.h>
+#include <string.h>
+
+// A task starved this many ticks in a row gets one slice even if it does not fit
+#define SCHEDULER_AGING_TICKS 15
+
+void scheduler_init(Scheduler* scheduler) {
+    memset(scheduler, 0, sizeof(Scheduler));
+    scheduler->cycles_per_us = furi_hal_cortex_instructions_per_microsecond();
+}
+
+int scheduler_add(Scheduler* scheduler, const char* name, SchedulerPriority priority, uint32_t budget_us, SchedulerStep step, void* ctx) {
+    if(scheduler->count == SCHEDULER_MAX_TASKS) return SCHEDULER_NONE;
+
+    int id = scheduler->count++;
+    SchedulerTask* task = &scheduler->tasks[id];
+    memset(task, 0, sizeof(SchedulerTask));
+    task->name = name;
+    task->step = step;
+    task->ctx = ctx;
+    task->priority = priority;
+    task->budget = budget_us * scheduler->cycles_per_us;
+    return id;
+}
+
+void scheduler_queue(Scheduler* scheduler, int task) {
+    if(task < 0 || task >= scheduler->count || scheduler->tasks[task].queued) return;
+    scheduler->tasks[task].queued = true;
+    scheduler->tasks[task].queued_tick = scheduler->tick;
+    scheduler->tasks[task].starved_run = 0;
+}
+
+bool scheduler_is_queued(const Scheduler* scheduler, int task) {
+    return task >= 0 && task < scheduler->count && scheduler->tasks[task].queued;
+}
+
+// Highest priority queued task that has budget left and whose longest
+// slice fits in the time left, SCHEDULER_NONE if there is none
+static int pick_task(const Scheduler* scheduler, const uint32_t* spent, uint32_t left) {
+    int best = SCHEDULER_NONE;
+    for(int i = 0; i < scheduler->count; i++) {
+        const SchedulerTask* task = &scheduler->tasks[i];
+        if(!task->queued || spent[i] >= task->budget) continue;
+        bool aged = task->starved_run >= SCHEDULER_AGING_TICKS && spent[i] == 0;
+        if((left == 0 || task->max_slice > left) && !aged) continue;
+        if(best == SCHEDULER_NONE || task->priority < scheduler->tasks[best].priority) best = i;
+    }
+    return best;
+}
+
+void scheduler_run(Scheduler* scheduler, uint32_t budget_us, SchedulerYield yield, void* yield_ctx) {
+    uint32_t start = DWT->CYCCNT;
+    uint32_t budget = budget_us * scheduler->cycles_per_us;
+    uint32_t spent[SCHEDULER_MAX_TASKS] = {0};
+    bool ran[SCHEDULER_MAX_TASKS] = {false};
+    bool any_queued = false;
+
+    for(int i = 0; i < scheduler->count; i++) {
+        any_queued |= scheduler->tasks[i].queued;
+    }
+    scheduler->tick++;
+    if(!any_queued) return;
+    if(budget == 0) scheduler->no_time_ticks++;
+
+    while(true) {
+        uint32_t used = DWT->CYCCNT - start;
+        int id = pick_task(scheduler, spent, used < budget ? budget - used : 0);
+        if(id == SCHEDULER_NONE) break;
+        if(yield && yield(yield_ctx)) {
+            scheduler->yield_ticks++;
+            break;
+        }
+
+        SchedulerTask* task = &scheduler->tasks[id];
+        uint32_t slice_start = DWT->CYCCNT;
+        bool finished = task->step(task->ctx);
+        uint32_t slice = DWT->CYCCNT - slice_start;
+
+        spent[id] += slice;
+        ran[id] = true;
+        task->slices++;
+        task->cycles += slice;
+        if(slice > task->max_slice) task->max_slice = slice;
+        if(slice > task->budget) task->overruns++;
+        if(finished) {
+            uint32_t latency = scheduler->tick - task->queued_tick;
+            task->queued = false;
+            task->completions++;
+            if(latency > task->latency_max) task->latency_max = latency;
+        }
+    }
+
+    // Everything still waiting without a slice this tick was delayed
+    for(int i = 0; i < scheduler->count; i++) {
+        SchedulerTask* task = &scheduler->tasks[i];
+        if(ran[i]) {
+            task->starved_run = 0;
+        } else if(task->queued) {
+            task->delayed_ticks++;
+            if(++task->starved_run > task->starved_max) task->starved_max = task->starved_run;
+        }
+    }
+}
+
+void scheduler_log(const Scheduler* scheduler) {
+    uint32_t per_us = scheduler->cycles_per_us ? scheduler->cycles_per_us : 1;
+    FURI_LOG_I("Sched", "%lu ticks, %lu without time left, %lu cut short by input", scheduler->tick,
+               scheduler->no_time_ticks, scheduler->yield_ticks);
+    for(int i = 0; i < scheduler->count; i++) {
+        const SchedulerTask* task = &scheduler->tasks[i];
+        FURI_LOG_I("Sched", "%s: %lu runs, %lu slices, %lu us total, max slice %lu us, %lu over budget",
+                   task->name, task->completions, task->slices, task->cycles / per_us, task->max_slice / per_us,
+                   task->overruns);
+        FURI_LOG_I("Sched", "%s: delayed %lu ticks, longest starved %lu, worst latency %lu ticks%s", task->name,
+                   task->delayed_ticks, task->starved_max, task->latency_max, task->queued ? ", still queued" : "");
+    }
+}
@@ -0,0 +1,75 @@
+// scheduler.h - Cooperative scheduler for background work in the time a tick leaves over
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define SCHEDULER_MAX_TASKS 8
+#define SCHEDULER_NONE      -1
+
+// Lower value runs first, tasks of the same priority in the order they were added
+typedef enum {
+    SchedulerPriorityHigh,
+    SchedulerPriorityNormal,
+    SchedulerPriorityLow,
+} SchedulerPriority;
+
+// One slice of a task: a small, bounded piece of work. Progress lives in
+// ctx (a little state machine), return true once the task is finished.
+typedef bool (*SchedulerStep)(void* ctx);
+
+// Polled before every slice, true hands the rest of the tick back to the game loop
+typedef bool (*SchedulerYield)(void* ctx);
+
+typedef struct {
+    const char* name;
+    SchedulerStep step;
+    void* ctx;
+    uint8_t priority;
+    bool queued;
+    uint32_t budget;        // Cycles the task may use per tick
+    uint32_t queued_tick;
+    // Statistics
+    uint32_t slices;
+    uint32_t cycles;
+    uint32_t max_slice;     // Longest single slice in cycles, also the estimate for the next one
+    uint32_t overruns;      // Slices that alone went over the task's budget
+    uint32_t delayed_ticks; // Ticks spent queued without getting a slice
+    uint32_t starved_run;   // Current run of such ticks
+    uint32_t starved_max;   // Longest run of such ticks
+    uint32_t completions;
+    uint32_t latency_max;   // Most ticks from queued to finished
+} SchedulerTask;
+
+typedef struct {
+    SchedulerTask tasks[SCHEDULER_MAX_TASKS];
+    uint8_t count;
+    uint32_t cycles_per_us;
+    uint32_t tick;
+    uint32_t no_time_ticks; // Work was queued but logic and drawing left no time
+    uint32_t yield_ticks;   // Work was cut short by pending input
+} Scheduler;
+
+void scheduler_init(Scheduler* scheduler);
+
+// Register a task, it does not run until queued. Returns its id or
+// SCHEDULER_NONE if the table is full.
+int scheduler_add(Scheduler* scheduler, const char* name, SchedulerPriority priority, uint32_t budget_us, SchedulerStep step, void* ctx);
+
+// Start (or restart) a task from the next run, no-op while it is queued
+void scheduler_queue(Scheduler* scheduler, int task);
+
+bool scheduler_is_queued(const Scheduler* scheduler, int task);
+
+// Run slices for at most budget_us, once per logic tick after logic and
+// the redraw request. A task gets another slice while its own budget for
+// this tick lasts and its longest slice so far still fits in the time left.
+// A task starved for a while gets a single slice regardless, so a slow
+// slice or a string of busy ticks delays work instead of dropping it.
+void scheduler_run(Scheduler* scheduler, uint32_t budget_us, SchedulerYield yield, void* yield_ctx);
+
+// Log per task time, delays and starvation
+void scheduler_log(const Scheduler* scheduler);
+
+#endif // SCHEDULER_H
@@ -0,0 +1,246 @@
+#include "script_vm.h"
+#include <furi.h>
+#include <storage/storage.h>
+#include <string.h>
+
+#define SCRIPT_HEADER_SIZE 8
+
+static inline uint16_t read_u16(const uint8_t* p) {
+    return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+void script_vm_init(ScriptVm* vm, const ScriptHost* host) {
+    memset(vm, 0, sizeof(ScriptVm));
+    vm->state.script = SCRIPT_NONE;
+    vm->host = host;
+}
+
+void script_vm_set_program(ScriptVm* vm, const ScriptProgram* program) {
+    vm->program = program;
+    vm->state.script = SCRIPT_NONE;
+    vm->state.waiting_host = false;
+    vm->state.wait_ticks = 0;
+}
+
+bool script_vm_start(ScriptVm* vm, int script) {
+    const ScriptProgram* program = vm->program;
+    if(program == NULL || script < 0 || script >= program->script_count) return false;
+
+    vm->state.script = (uint8_t)script;
+    vm->state.pc = read_u16(&program->scripts[script * 2]);
+    vm->state.sp = 0;
+    vm->state.wait_ticks = 0;
+    vm->state.waiting_host = false;
+    return true;
+}
+
+void script_vm_resume(ScriptVm* vm) {
+    vm->state.waiting_host = false;
+}
+
+bool script_vm_is_active(const ScriptVm* vm) {
+    return vm->state.script != SCRIPT_NONE;
+}
+
+bool script_vm_get_flag(const ScriptVm* vm, int flag) {
+    if(flag < 0 || flag >= SCRIPT_FLAG_COUNT) return false;
+    return (vm->state.flags[flag / 8] >> (flag % 8)) & 1;
+}
+
+void script_vm_set_flag(ScriptVm* vm, int flag, bool value) {
+    if(flag < 0 || flag >= SCRIPT_FLAG_COUNT) return;
+    if(value) {
+        vm->state.flags[flag / 8] |= 1 << (flag % 8);
+    } else {
+        vm->state.flags[flag / 8] &= ~(1 << (flag % 8));
+    }
+}
+
+static ScriptStatus stop(ScriptVm* vm, ScriptStatus status) {
+    vm->state.script = SCRIPT_NONE;
+    return status;
+}
+
+ScriptStatus script_vm_run(ScriptVm* vm, int max_instructions) {
+    ScriptVmState* s = &vm->state;
+    const ScriptProgram* program = vm->program;
+    const ScriptHost* host = vm->host;
+
+    if(s->script == SCRIPT_NONE) return ScriptStatusIdle;
+    if(s->waiting_host) return ScriptStatusWaiting;
+    if(s->wait_ticks > 0) {
+        s->wait_ticks--;
+        return ScriptStatusWaiting;
+    }
+
+// Operand helpers, any stack or code overrun stops the script
+#define NEED_CODE(n) if(s->pc + (n) > program->code_size) return stop(vm, ScriptStatusError)
+#define POP(var) if(s->sp == 0) return stop(vm, ScriptStatusError); int var = s->stack[--s->sp]
+#define PUSH(value) if(s->sp == SCRIPT_STACK_DEPTH) return stop(vm, ScriptStatusError); s->stack[s->sp++] = (int16_t)(value)
+
+    for(int executed = 0; executed < max_instructions; executed++) {
+        NEED_CODE(1);
+        uint8_t op = program->code[s->pc++];
+
+        switch(op) {
+            case ScriptOpEnd:
+                return stop(vm, ScriptStatusIdle);
+
+            case ScriptOpPush8: {
+                NEED_CODE(1);
+                PUSH((int8_t)program->code[s->pc]);
+                s->pc += 1;
+                break;
+            }
+
+            case ScriptOpPush16: {
+                NEED_CODE(2);
+                PUSH((int16_t)read_u16(&program->code[s->pc]));
+                s->pc += 2;
+                break;
+            }
+
+            case ScriptOpDialog: {
+                POP(string);
+                if(string < 0 || string >= program->string_count) return stop(vm, ScriptStatusError);
+                const char* text = program->string_data + read_u16(&program->strings[string * 2]);
+                s->waiting_host = host->dialog && host->dialog(host->ctx, text);
+                break;
+            }
+
+            case ScriptOpMoveNpc: {
+                POP(steps);
+                POP(direction);
+                POP(npc);
+                s->waiting_host = host->move_npc && host->move_npc(host->ctx, npc, direction, steps);
+                break;
+            }
+
+            case ScriptOpGiveItem: {
+                POP(quantity);
+                POP(item);
+                s->waiting_host = host->give_item && host->give_item(host->ctx, item, quantity);
+                break;
+            }
+
+            case ScriptOpBattle: {
+                POP(level);
+                POP(species);
+                s->waiting_host = host->start_battle && host->start_battle(host->ctx, species, level);
+                break;
+            }
+
+            case ScriptOpSetFlag: {
+                POP(flag);
+                script_vm_set_flag(vm, flag, true);
+                break;
+            }
+
+            case ScriptOpClearFlag: {
+                POP(flag);
+                script_vm_set_flag(vm, flag, false);
+                break;
+            }
+
+            case ScriptOpGetFlag: {
+                POP(flag);
+                PUSH(script_vm_get_flag(vm, flag));
+                break;
+            }
+
+            case ScriptOpJump: {
+                NEED_CODE(2);
+                s->pc = read_u16(&program->code[s->pc]);
+                break;
+            }
+
+            case ScriptOpJumpIfZero: {
+                NEED_CODE(2);
+                POP(value);
+                s->pc = value == 0 ? read_u16(&program->code[s->pc]) : s->pc + 2;
+                break;
+            }
+
+            case ScriptOpWait: {
+                POP(ticks);
+                s->wait_ticks = ticks > 0 ? (uint16_t)ticks : 0;
+                break;
+            }
+
+            default:
+                FURI_LOG_E("Script", "Bad opcode %d at %d", op, s->pc - 1);
+                return stop(vm, ScriptStatusError);
+        }
+
+        // Blocking instructions hand control back to the game loop
+        if(s->waiting_host || s->wait_ticks > 0) return ScriptStatusWaiting;
+    }
+
+#undef NEED_CODE
+#undef POP
+#undef PUSH
+
+    return ScriptStatusRunning;
+}
+
+bool script_program_parse(ScriptProgram* program, const uint8_t* data, size_t size) {
+    memset(program, 0, sizeof(ScriptProgram));
+    if(size < SCRIPT_HEADER_SIZE || memcmp(data, SCRIPT_FILE_MAGIC, 4) != 0) return false;
+
+    uint8_t script_count = data[4];
+    uint8_t string_count = data[5];
+    uint16_t code_size = read_u16(&data[6]);
+    size_t code_offset = SCRIPT_HEADER_SIZE + (script_count + string_count) * 2;
+    if(code_offset + code_size > size) return false;
+
+    program->data = data;
+    program->size = size;
+    program->script_count = script_count;
+    program->string_count = string_count;
+    program->scripts = data + SCRIPT_HEADER_SIZE;
+    program->strings = program->scripts + script_count * 2;
+    program->code = data + code_offset;
+    program->code_size = code_size;
+    program->string_data = (const char*)(program->code + code_size);
+    program->string_size = size - code_offset - code_size;
+
+    // Entry points must be inside the code and strings must be terminated
+    for(int i = 0; i < script_count; i++) {
+        if(read_u16(&program->scripts[i * 2]) >= code_size) return false;
+    }
+    for(int i = 0; i < string_count; i++) {
+        uint16_t offset = read_u16(&program->strings[i * 2]);
+        if(offset >= program->string_size ||
+           memchr(program->string_data + offset, '\0', program->string_size - offset) == NULL) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool script_program_load(ScriptProgram* program, const char* path, Arena* arena) {
+    memset(program, 0, sizeof(ScriptProgram));
+
+    Storage* storage = furi_record_open(RECORD_STORAGE);
+    File* file = storage_file_alloc(storage);
+    size_t mark = arena_mark(arena);
+    bool loaded = false;
+
+    if(storage_file_open(file, path, FSAM_READ, FSOM_OPEN_EXISTING)) {
+        size_t size = storage_file_size(file);
+        uint8_t* data = arena_alloc(arena, size);
+        if(data && storage_file_read(file, data, size) == size) {
+            loaded = script_program_parse(program, data, size);
+        }
+        storage_file_close(file);
+    }
+
+    storage_file_free(file);
+    furi_record_close(RECORD_STORAGE);
+
+    if(!loaded) {
+        arena_release(arena, mark);
+        memset(program, 0, sizeof(ScriptProgram));
+    }
+    return loaded;
+}
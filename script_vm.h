@@ -0,0 +1,110 @@
+// script_vm.h - Small stack based bytecode interpreter for cutscenes and NPC scripts
+#ifndef SCRIPT_VM_H
+#define SCRIPT_VM_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "arena.h"
+
+#define SCRIPT_STACK_DEPTH 8
+#define SCRIPT_FLAG_COUNT  128
+#define SCRIPT_NONE        0xFF   // No script running
+#define SCRIPT_FILE_MAGIC  "FMS1"
+
+// Opcodes. Immediates follow the opcode little endian, every other operand
+// is popped from the stack (last argument on top).
+typedef enum {
+    ScriptOpEnd,        // Stop the script
+    ScriptOpPush8,      // imm8: push a signed byte
+    ScriptOpPush16,     // imm16: push a signed word
+    ScriptOpDialog,     // string -- : show text, wait for the player
+    ScriptOpMoveNpc,    // npc direction steps -- : walk an NPC, wait until it arrives
+    ScriptOpGiveItem,   // item quantity -- : add to the bag
+    ScriptOpBattle,     // species level -- : start a wild battle, wait until it ends
+    ScriptOpSetFlag,    // flag --
+    ScriptOpClearFlag,  // flag --
+    ScriptOpGetFlag,    // flag -- value
+    ScriptOpJump,       // imm16: jump to code offset
+    ScriptOpJumpIfZero, // value -- ; imm16: jump to code offset if value is 0
+    ScriptOpWait,       // ticks -- : pause for logic ticks
+    ScriptOpCount
+} ScriptOp;
+
+typedef enum {
+    ScriptStatusIdle,    // No script running
+    ScriptStatusRunning, // Instruction budget ran out, continue next tick
+    ScriptStatusWaiting, // Blocked on the host (dialog, NPC, battle) or a wait
+    ScriptStatusError,   // Bad bytecode, the script was stopped
+} ScriptStatus;
+
+// A map's compiled scripts as loaded from the SD card:
+//   "FMS1", u8 script_count, u8 string_count, u16 code_size,
+//   u16 script_offsets[script_count], u16 string_offsets[string_count],
+//   code[code_size], NUL terminated strings
+typedef struct {
+    const uint8_t* data;  // Whole file, owned by the loader's arena
+    size_t size;
+    uint8_t script_count;
+    uint8_t string_count;
+    const uint8_t* scripts; // Offsets into code
+    const uint8_t* strings; // Offsets into the string area
+    const uint8_t* code;
+    uint16_t code_size;
+    const char* string_data;
+    size_t string_size;
+} ScriptProgram;
+
+// Everything needed to resume a script, a few dozen bytes for the save file
+typedef struct {
+    uint8_t script;       // Running script index or SCRIPT_NONE
+    uint8_t sp;
+    uint16_t pc;
+    uint16_t wait_ticks;  // Remaining ScriptOpWait ticks
+    bool waiting_host;    // Blocked until script_vm_resume
+    int16_t stack[SCRIPT_STACK_DEPTH];
+    uint8_t flags[SCRIPT_FLAG_COUNT / 8]; // Story flags, kept across maps
+} ScriptVmState;
+
+// Game side of the VM. Returning true blocks the script until the game
+// calls script_vm_resume (dialog dismissed, NPC arrived, battle over).
+typedef struct {
+    bool (*dialog)(void* ctx, const char* text);
+    bool (*move_npc)(void* ctx, int npc, int direction, int steps);
+    bool (*give_item)(void* ctx, int item, int quantity);
+    bool (*start_battle)(void* ctx, int species, int level);
+    void* ctx;
+} ScriptHost;
+
+typedef struct {
+    ScriptVmState state;
+    const ScriptProgram* program;
+    const ScriptHost* host;
+} ScriptVm;
+
+void script_vm_init(ScriptVm* vm, const ScriptHost* host);
+
+// Switch to another map's program, any running script is stopped
+void script_vm_set_program(ScriptVm* vm, const ScriptProgram* program);
+
+// Start a script of the current program, false if it does not exist
+bool script_vm_start(ScriptVm* vm, int script);
+
+// Unblock a script waiting on the host
+void script_vm_resume(ScriptVm* vm);
+
+// Run at most max_instructions, called once per logic tick
+ScriptStatus script_vm_run(ScriptVm* vm, int max_instructions);
+
+bool script_vm_is_active(const ScriptVm* vm);
+bool script_vm_get_flag(const ScriptVm* vm, int flag);
+void script_vm_set_flag(ScriptVm* vm, int flag, bool value);
+
+// Parse a compiled program in place, false if the data is malformed
+bool script_program_parse(ScriptProgram* program, const uint8_t* data, size_t size);
+
+// Read and parse a compiled program from storage into arena memory, the
+// program stays valid until the arena is released below it
+bool script_program_load(ScriptProgram* program, const char* path, Arena* arena);
+
+#endif // SCRIPT_VM_H
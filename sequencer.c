@@ -0,0 +1,211 @@
+#include "sequencer.h"
+#include <furi_hal.h>
+#include <string.h>
+
+#define SEQUENCER_VOLUME    0.4f
+#define SEQUENCER_FETCH_MAX 8  // Stream bytes read per tick at most, a song without notes stops
+#define SEQUENCER_STOP_WAIT 4  // Ticks sequencer_stop waits for the output to go quiet
+
+// Octave 2, higher octaves double
+static const float note_frequencies[12] = {
+    65.41f, 69.30f, 73.42f, 77.78f, 82.41f, 87.31f, 92.50f, 98.00f, 103.83f, 110.00f, 116.54f, 123.47f,
+};
+
+static float note_frequency(uint8_t note) {
+    int semitone = note - 1;
+    return note_frequencies[semitone % 12] * (float)(1 << (semitone / 12));
+}
+
+static void channel_start(SequencerChannel* channel, const Song* song) {
+    memset(channel, 0, sizeof(SequencerChannel));
+    if(song == NULL) return;
+    channel->song = song;
+    channel->pc = song->data;
+    channel->length = 1;
+    channel->active = true;
+}
+
+static void channel_silence(SequencerChannel* channel) {
+    channel->active = false;
+    channel->note = SONG_REST;
+}
+
+// Count down the current note and fetch the next one once it ran out
+static void channel_step(SequencerChannel* channel) {
+    channel->started = false;
+    if(!channel->active) return;
+    if(channel->remaining > 1) {
+        channel->remaining--;
+        return;
+    }
+
+    for(int fetched = 0; fetched < SEQUENCER_FETCH_MAX; fetched++) {
+        uint8_t op = *channel->pc++;
+        if(op == SONG_OP_END) {
+            channel_silence(channel);
+            return;
+        }
+        if(op == SONG_OP_LOOP) {
+            channel->pc = channel->song->data;
+            continue;
+        }
+        if(op & SONG_OP_LENGTH) {
+            channel->length = (op & SONG_LENGTH_MASK) ? (op & SONG_LENGTH_MASK) : 1;
+            continue;
+        }
+        channel->note = op <= SONG_NOTE_MAX ? op : SONG_REST;
+        channel->remaining = channel->length;
+        channel->started = true;
+        return;
+    }
+    channel_silence(channel);
+}
+
+// Pick up whatever the game thread asked for since the last tick
+static void apply_requests(Sequencer* sequencer) {
+    if(sequencer->stop_request) {
+        channel_silence(&sequencer->music);
+        channel_silence(&sequencer->sfx);
+        return;
+    }
+
+    uint8_t serial = sequencer->music_serial;
+    if(serial != sequencer->music_seen) {
+        sequencer->music_seen = serial;
+        const Song* song = sequencer->music_request;
+        if(song != sequencer->music.song || !sequencer->music.active) channel_start(&sequencer->music, song);
+    }
+
+    serial = sequencer->sfx_serial;
+    if(serial != sequencer->sfx_seen) {
+        sequencer->sfx_seen = serial;
+        const Song* song = sequencer->sfx_request;
+        if(song == NULL || !sequencer->sfx.active || song->priority >= sequencer->sfx.song->priority) {
+            channel_start(&sequencer->sfx, song);
+        }
+    }
+}
+
+// Timer callback: advance both channels by one tick and update the output
+static void sequencer_tick(void* ctx) {
+    Sequencer* sequencer = ctx;
+    uint32_t now = DWT->CYCCNT;
+    if(sequencer->ticks > 0) {
+        uint32_t interval = now - sequencer->last_tick;
+        uint32_t jitter = interval > sequencer->period ? interval - sequencer->period : sequencer->period - interval;
+        if(jitter > sequencer->jitter_max) sequencer->jitter_max = jitter;
+    }
+    sequencer->last_tick = now;
+    sequencer->ticks++;
+
+    apply_requests(sequencer);
+    channel_step(&sequencer->music);
+    channel_step(&sequencer->sfx);
+
+    // A sound effect owns the output while it plays, rests included; the
+    // music keeps counting underneath and comes back in time
+    const SequencerChannel* channel = sequencer->sfx.active ? &sequencer->sfx : &sequencer->music;
+    uint8_t note = channel->active ? channel->note : SONG_REST;
+    const SequencerOutput* output = &sequencer->output;
+    if(note == SONG_REST) {
+        if(sequencer->sounding != SONG_REST) output->note_off(output->ctx);
+    } else if(note != sequencer->sounding || channel->started) {
+        output->note_on(output->ctx, note, note_frequency(note));
+    }
+    sequencer->sounding = note;
+
+    uint32_t cost = DWT->CYCCNT - now;
+    sequencer->cost_total += cost;
+    if(cost > sequencer->cost_max) sequencer->cost_max = cost;
+}
+
+void sequencer_start(Sequencer* sequencer, SequencerOutput output) {
+    memset(sequencer, 0, sizeof(Sequencer));
+    sequencer->output = output;
+
+    // A period that is not a whole number of kernel ticks would be rounded
+    // and every song would play off tempo
+    furi_check(furi_kernel_get_tick_frequency() % SEQUENCER_HZ == 0);
+    uint32_t period_ticks = furi_kernel_get_tick_frequency() / SEQUENCER_HZ;
+    sequencer->period = (uint32_t)((uint64_t)period_ticks * 1000000 / furi_kernel_get_tick_frequency()) *
+                        furi_hal_cortex_instructions_per_microsecond();
+    sequencer->timer = furi_timer_alloc(sequencer_tick, FuriTimerTypePeriodic, sequencer);
+    furi_timer_start(sequencer->timer, period_ticks);
+}
+
+void sequencer_stop(Sequencer* sequencer) {
+    if(sequencer->timer == NULL) return;
+
+    // The speaker belongs to the timer thread, let it switch off the last note
+    sequencer->stop_request = true;
+    for(int i = 0; i < SEQUENCER_STOP_WAIT && sequencer->sounding != SONG_REST; i++) {
+        furi_delay_ms(1000 / SEQUENCER_HZ);
+    }
+    furi_timer_stop(sequencer->timer);
+    furi_timer_free(sequencer->timer);
+    sequencer->timer = NULL;
+
+    uint32_t per_us = furi_hal_cortex_instructions_per_microsecond();
+    FURI_LOG_I("Seq", "%lu ticks, max jitter %lu us, cost avg %lu max %lu us", sequencer->ticks,
+               sequencer->jitter_max / per_us, sequencer->ticks ? sequencer->cost_total / sequencer->ticks / per_us : 0,
+               sequencer->cost_max / per_us);
+}
+
+void sequencer_play_music(Sequencer* sequencer, const Song* song) {
+    sequencer->music_request = song;
+    sequencer->music_serial++;
+}
+
+void sequencer_play_sfx(Sequencer* sequencer, const Song* song) {
+    sequencer->sfx_request = song;
+    sequencer->sfx_serial++;
+}
+
+// ---------------- OUTPUTS ---------------- //
+
+static void speaker_note_on(void* ctx, uint8_t note, float frequency) {
+    (void)ctx;
+    (void)note;
+    if(furi_hal_rtc_is_flag_set(FuriHalRtcFlagStealthMode)) return;
+    // Another app or the system holds the speaker: skip the note, never wait
+    if(!furi_hal_speaker_is_mine() && !furi_hal_speaker_acquire(0)) return;
+    furi_hal_speaker_start(frequency, SEQUENCER_VOLUME);
+}
+
+static void speaker_note_off(void* ctx) {
+    (void)ctx;
+    if(!furi_hal_speaker_is_mine()) return;
+    furi_hal_speaker_stop();
+    furi_hal_speaker_release();
+}
+
+SequencerOutput sequencer_speaker_output(void) {
+    return (SequencerOutput){speaker_note_on, speaker_note_off, NULL};
+}
+
+// Cycle stamp of the previous logged event, for exact intervals between notes
+static uint32_t log_last_cycles;
+
+static uint32_t log_interval_us(void) {
+    uint32_t now = DWT->CYCCNT;
+    uint32_t interval = (now - log_last_cycles) / furi_hal_cortex_instructions_per_microsecond();
+    log_last_cycles = now;
+    return interval;
+}
+
+static void log_note_on(void* ctx, uint8_t note, float frequency) {
+    (void)ctx;
+    uint32_t interval = log_interval_us();
+    FURI_LOG_I("Seq", "%lu ms (+%lu us) on %u %lu Hz", furi_get_tick(), interval, note, (uint32_t)frequency);
+}
+
+static void log_note_off(void* ctx) {
+    (void)ctx;
+    uint32_t interval = log_interval_us();
+    FURI_LOG_I("Seq", "%lu ms (+%lu us) off", furi_get_tick(), interval);
+}
+
+SequencerOutput sequencer_log_output(void) {
+    log_last_cycles = DWT->CYCCNT;
+    return (SequencerOutput){log_note_on, log_note_off, NULL};
+}
@@ -0,0 +1,96 @@
+// sequencer.h - Timer driven music and sound effect player for tracker style note streams
+#ifndef SEQUENCER_H
+#define SEQUENCER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <furi.h>
+
+#define SEQUENCER_HZ 50 // Note lengths are counted in these ticks, must divide the kernel tick rate
+
+// Song byte stream, see tools/gen_songs.py:
+//   0x00              rest
+//   0x01..0x5F        note, semitones above C2 plus one
+//   0x80 | ticks      length of the following notes and rests (1..63 ticks)
+//   SONG_OP_LOOP      back to the first byte
+//   SONG_OP_END       stop
+#define SONG_REST        0x00
+#define SONG_NOTE_MAX    0x5F
+#define SONG_OP_LENGTH   0x80
+#define SONG_LENGTH_MASK 0x3F
+#define SONG_OP_LOOP     0xFE
+#define SONG_OP_END      0xFF
+
+// Music has priority 0. A sound effect starts if nothing of higher
+// priority is playing and silences the music while it lasts.
+typedef struct {
+    const uint8_t* data;
+    uint8_t priority;
+} Song;
+
+// Where notes go: the speaker on device, or a log of note events with
+// timestamps when the timing itself is under test. Called on the timer
+// thread only.
+typedef struct {
+    void (*note_on)(void* ctx, uint8_t note, float frequency);
+    void (*note_off)(void* ctx);
+    void* ctx;
+} SequencerOutput;
+
+typedef struct {
+    const Song* song;
+    const uint8_t* pc;
+    uint8_t length;    // Ticks per note
+    uint8_t remaining; // Ticks left of the current note
+    uint8_t note;      // Current note, SONG_REST while resting
+    bool started;      // A note began this tick
+    bool active;
+} SequencerChannel;
+
+// The game thread only posts requests, the timer callback applies them and
+// owns everything else, so playing a song never waits on the speaker. A
+// request is the song pointer followed by a bumped serial; the timer picks
+// up the latest one whenever the serial moved.
+typedef struct {
+    SequencerOutput output;
+    FuriTimer* timer;
+    SequencerChannel music;
+    SequencerChannel sfx;
+    volatile uint8_t sounding; // Note on the output, SONG_REST when silent
+    const Song* volatile music_request;
+    const Song* volatile sfx_request;
+    volatile uint8_t music_serial;
+    volatile uint8_t sfx_serial;
+    uint8_t music_seen;
+    uint8_t sfx_seen;
+    volatile bool stop_request;
+    // Statistics, in cycles
+    uint32_t period;
+    uint32_t last_tick;
+    uint32_t ticks;
+    uint32_t jitter_max;  // Largest distance of a tick from its period
+    uint32_t cost_total;
+    uint32_t cost_max;
+} Sequencer;
+
+// Start the timer, silent until a song is requested
+void sequencer_start(Sequencer* sequencer, SequencerOutput output);
+
+// Silence the output, stop the timer and log timing statistics. Waits a
+// few ticks for the timer thread to let go of the speaker.
+void sequencer_stop(Sequencer* sequencer);
+
+// Switch the music from the next tick, NULL for none. Requesting the song
+// that is already playing keeps it going.
+void sequencer_play_music(Sequencer* sequencer, const Song* song);
+
+// Play a sound effect over the music if its priority allows
+void sequencer_play_sfx(Sequencer* sequencer, const Song* song);
+
+// Speaker output, skipped while the Flipper is in stealth mode
+SequencerOutput sequencer_speaker_output(void);
+
+// Logs every note event with its time, for checking timing without sound
+SequencerOutput sequencer_log_output(void);
+
+#endif // SEQUENCER_H
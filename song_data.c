@@ -0,0 +1,20 @@
+// song_data.c - Generated by tools/gen_songs.py, do not edit
+#include "song_data.h"
+
+static const uint8_t song_bytes[] = {
+    0x94, 0x25, 0x8a, 0x29, 0x2c, 0x94, 0x2e, 0x8a, 0x2c, 0x29, 0x94, 0x2a, 0x2e, 0x2c, 0x8a, 0x00,
+    0x00, 0x94, 0x29, 0x8a, 0x2c, 0x31, 0x94, 0x30, 0x8a, 0x2c, 0x29, 0x94, 0x27, 0x20, 0x9e, 0x25,
+    0x8a, 0x00, 0x25, 0x29, 0x2c, 0x29, 0x94, 0x2e, 0x2c, 0x8a, 0x2a, 0x29, 0x27, 0x29, 0x94, 0x2a,
+    0x2e, 0x2c, 0x8a, 0x29, 0x25, 0x94, 0x27, 0x24, 0xa8, 0x25, 0x8a, 0x00, 0x00, 0x00, 0x00, 0xfe,
+    0x85, 0x22, 0x22, 0x25, 0x22, 0x27, 0x22, 0x29, 0x22, 0x2a, 0x29, 0x27, 0x25, 0x24, 0x25, 0x27,
+    0x29, 0x22, 0x22, 0x25, 0x22, 0x27, 0x22, 0x29, 0x22, 0x2c, 0x2a, 0x29, 0x27, 0x94, 0x29, 0x85,
+    0x1e, 0x22, 0x25, 0x2a, 0x29, 0x25, 0x22, 0x25, 0x20, 0x24, 0x27, 0x2c, 0x2a, 0x27, 0x24, 0x27,
+    0x22, 0x25, 0x29, 0x2e, 0x8a, 0x2d, 0x29, 0x2e, 0x00, 0x85, 0x29, 0x27, 0x25, 0x24, 0xfe, 0x82,
+    0x31, 0x2c, 0x27, 0x22, 0x00, 0xff,
+};
+
+const Song songs[SONG_COUNT] = {
+    [SONG_OVERWORLD] = {song_bytes + 0, 0},
+    [SONG_BATTLE] = {song_bytes + 64, 0},
+    [SONG_HIT] = {song_bytes + 127, 2},
+};
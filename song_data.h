@@ -0,0 +1,17 @@
+// song_data.h - Generated by tools/gen_songs.py, do not edit
+// 3 songs, 96 notes in 134 bytes
+#ifndef SONG_DATA_H
+#define SONG_DATA_H
+
+#include "sequencer.h"
+
+typedef enum {
+    SONG_OVERWORLD,
+    SONG_BATTLE,
+    SONG_HIT,
+    SONG_COUNT
+} SongId;
+
+extern const Song songs[SONG_COUNT];
+
+#endif // SONG_DATA_H
@@ -0,0 +1,82 @@
+#include "sprite_cache.h"
+#include <string.h>
+
+#define SCREEN_WIDTH  128
+#define SCREEN_PAGES  8
+#define SCREEN_BYTES  (SCREEN_WIDTH * SCREEN_PAGES)
+
+void sprite_cache_clear(SpriteCache* cache) {
+    cache->count = 0;
+}
+
+// Whole sprite column as a word with the top row in bit 0, bits or mask
+static uint32_t sprite_column(const MaskedSprite* sprite, int x, int plane) {
+    uint32_t column = 0;
+    for(int page = 0; page < SPRITE_CACHE_SIZE / 8; page++) {
+        column |= (uint32_t)masked_sprite_column(sprite, page, x)[plane] << (page * 8);
+    }
+    return column;
+}
+
+bool sprite_cache_load(SpriteCache* cache, Arena* arena, const MaskedSprite* source) {
+    for(int i = 0; i < cache->count; i++) {
+        if(cache->keys[i] == source) return true;
+    }
+    if(source->width != SPRITE_CACHE_SIZE || source->height != SPRITE_CACHE_SIZE) return false;
+    if(cache->count == SPRITE_CACHE_SLOTS) return false;
+
+    ShiftedSprite* sprite = arena_alloc(arena, sizeof(ShiftedSprite));
+    if(sprite == NULL) return false;
+
+    for(int x = 0; x < SPRITE_CACHE_SIZE; x++) {
+        uint32_t image = sprite_column(source, x, 0);
+        uint32_t opaque = sprite_column(source, x, 1);
+
+        for(int shift = 0; shift < SPRITE_CACHE_SHIFTS; shift++) {
+            for(int page = 0; page < SPRITE_CACHE_PAGES; page++) {
+                sprite->image[shift][page][x] = (uint8_t)((image << shift) >> (page * 8));
+                sprite->mask[shift][page][x] = (uint8_t)((opaque << shift) >> (page * 8));
+            }
+        }
+    }
+
+    cache->keys[cache->count] = source;
+    cache->sprites[cache->count] = sprite;
+    cache->count++;
+    return true;
+}
+
+void sprite_cache_draw(const SpriteCache* cache, Canvas* canvas, const MaskedSprite* source, int x, int y) {
+    const ShiftedSprite* sprite = NULL;
+    for(int i = 0; i < cache->count; i++) {
+        if(cache->keys[i] == source) {
+            sprite = cache->sprites[i];
+            break;
+        }
+    }
+    if(sprite == NULL || canvas_get_buffer_size(canvas) != SCREEN_BYTES) {
+        masked_sprite_draw(canvas, source, x, y);
+        return;
+    }
+
+    // Clip columns, then every remaining byte is a plain mask-and-set
+    int first = x < 0 ? -x : 0;
+    int last = x + SPRITE_CACHE_SIZE > SCREEN_WIDTH ? SCREEN_WIDTH - x : SPRITE_CACHE_SIZE;
+    if(first >= last) return;
+
+    int top_page = y >= 0 ? y / 8 : -((7 - y) / 8);
+    int shift = y - top_page * 8;
+    uint8_t* screen = canvas_get_buffer(canvas);
+
+    for(int page = 0; page < SPRITE_CACHE_PAGES; page++) {
+        int screen_page = top_page + page;
+        if(screen_page < 0 || screen_page >= SCREEN_PAGES) continue;
+
+        uint8_t* dst = screen + screen_page * SCREEN_WIDTH + x;
+        const uint8_t* image = sprite->image[shift][page];
+        const uint8_t* mask = sprite->mask[shift][page];
+        for(int i = first; i < last; i++) {
+            dst[i] = (dst[i] & ~mask[i]) | image[i];
+        }
+    }
+}
@@ -0,0 +1,43 @@
+// sprite_cache.h - 16x16 sprites pre-shifted into display page format
+#ifndef SPRITE_CACHE_H
+#define SPRITE_CACHE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <gui/gui.h>
+#include "arena.h"
+#include "masked_sprite.h"
+
+#define SPRITE_CACHE_SIZE   16 // Sprite width and height in pixels
+#define SPRITE_CACHE_PAGES  3  // Display pages a shifted sprite can touch
+#define SPRITE_CACHE_SHIFTS 8  // Vertical offsets within a page
+#define SPRITE_CACHE_SLOTS  16
+
+// The display stores 8 pixel tall pages as one byte per column, so moving
+// a sprite sideways is free and only the vertical offset inside a page
+// needs shifting. Each variant is ready to AND-NOT/OR into the screen.
+typedef struct {
+    uint8_t image[SPRITE_CACHE_SHIFTS][SPRITE_CACHE_PAGES][SPRITE_CACHE_SIZE];
+    uint8_t mask[SPRITE_CACHE_SHIFTS][SPRITE_CACHE_PAGES][SPRITE_CACHE_SIZE];
+} ShiftedSprite;
+
+// Sprites of the current scene, keyed by their MaskedSprite. Built on the game
+// thread when a scene loads and read by the draw callback; the memory
+// comes from the scene arena, so clear the cache whenever it is released.
+typedef struct {
+    const MaskedSprite* keys[SPRITE_CACHE_SLOTS];
+    ShiftedSprite* sprites[SPRITE_CACHE_SLOTS];
+    int count;
+} SpriteCache;
+
+void sprite_cache_clear(SpriteCache* cache);
+
+// Build all shifts of a 16x16 sprite. False if the sprite has another
+// size or the cache or the arena is full.
+bool sprite_cache_load(SpriteCache* cache, Arena* arena, const MaskedSprite* sprite);
+
+// Draw a cached sprite at any position, clipped to the screen. Falls back
+// to masked_sprite_draw for sprites that are not cached.
+void sprite_cache_draw(const SpriteCache* cache, Canvas* canvas, const MaskedSprite* sprite, int x, int y);
+
+#endif // SPRITE_CACHE_H
@@ -1,53 +0,0 @@
-
-
-
-// Player sprites
-const unsigned char trainer_backward_standing [32] = {
-	0xe0, 0x07, 0x10, 0x08, 0x08, 0x10, 0x08, 0x10, 0x0c, 0x30, 0x1c, 0x38, 0xfa, 0x5f, 0xf2, 0x4f, 
-	0xcc, 0x33, 0x3c, 0x3c, 0xda, 0x5b, 0x1a, 0x58, 0x3c, 0x3c, 0xe8, 0x17, 0x48, 0x12, 0x70, 0x0e
-};
-// 'trainer_backwards_walking_left', 16x16px
-const unsigned char trainer_backwards_walking_left [32] = {
-	0x00, 0x00, 0xe0, 0x07, 0x10, 0x08, 0x08, 0x10, 0x08, 0x10, 0x0c, 0x30, 0x1c, 0x38, 0xfa, 0x5f, 
-	0xf2, 0x4f, 0xce, 0x33, 0x3a, 0x3c, 0xdc, 0x4b, 0x18, 0x48, 0x30, 0x3c, 0xd0, 0x03, 0xe0, 0x00
-};
-// 'trainer_backwards_walking_right', 16x16px
-const unsigned char trainer_backwards_walking_right [32] = {
-	0xe0, 0x07, 0x10, 0x08, 0x08, 0x10, 0x08, 0x10, 0x0c, 0x30, 0x1c, 0x38, 0xfa, 0x5f, 0xf2, 0x4f, 
-	0xce, 0x33, 0x3a, 0x3c, 0xdc, 0x4b, 0x18, 0x48, 0x30, 0x3c, 0xd0, 0x03, 0xe0, 0x00, 0x00, 0x00
-};
-// 'trainer_forward_normal', 16x16px
-const unsigned char trainer_forward_normal [32] = {
-	0xe0, 0x07, 0x10, 0x08, 0x08, 0x10, 0xe8, 0x17, 0x1c, 0x38, 0xec, 0x3f, 0x0a, 0x50, 0x42, 0x42, 
-	0x4c, 0x32, 0x18, 0x18, 0xfc, 0x3f, 0x92, 0x49, 0x12, 0x48, 0xfc, 0x3f, 0xc8, 0x13, 0x70, 0x0e
-};
-// 'trainer_front_walking_left', 16x16px
-const unsigned char trainer_front_walking_left [32]  = {
-	0x00, 0x00, 0xe0, 0x07, 0x10, 0x08, 0x08, 0x10, 0xe8, 0x17, 0x1c, 0x38, 0xfc, 0x37, 0x0a, 0x50, 
-	0x42, 0x42, 0x4e, 0x32, 0x1a, 0x38, 0xfc, 0x1f, 0x94, 0x13, 0x38, 0x12, 0xc8, 0x0f, 0x70, 0x00
-};
-// 'trainer_front_walking_right', 16x16px
-const unsigned char trainer_front_walking_right [32]  = {
-	0x00, 0x00, 0xe0, 0x07, 0x10, 0x08, 0x08, 0x10, 0xe8, 0x17, 0x1c, 0x38, 0xec, 0x3f, 0x0a, 0x50, 
-	0x42, 0x42, 0x4c, 0x72, 0x1c, 0x58, 0xf8, 0x3f, 0xc8, 0x29, 0x48, 0x1c, 0xf0, 0x13, 0x00, 0x0e
-};
-// 'trainer_left_standing', 16x16px
-const unsigned char trainer_left_standing [32] = {
-	0xc0, 0x0f, 0x20, 0x10, 0x10, 0x20, 0xf0, 0x20, 0x08, 0x21, 0xf0, 0x3f, 0x50, 0x3e, 0x50, 0x32, 
-	0x10, 0x30, 0x20, 0x1c, 0xc0, 0x27, 0xc0, 0x27, 0x80, 0x24, 0xc0, 0x1c, 0xe0, 0x0b, 0xc0, 0x07
-};
-// 'trainer_left_walking', 16x16px
-const unsigned char trainer_left_walking [32] = {
-	0xc0, 0x0f, 0x20, 0x10, 0x10, 0x20, 0xf0, 0x20, 0x08, 0x21, 0xf0, 0x3f, 0x50, 0x3e, 0x50, 0x32, 
-	0x10, 0x30, 0x20, 0x1c, 0xc0, 0x2f, 0x60, 0x32, 0x90, 0x52, 0x20, 0x4f, 0xc0, 0x30, 0xc0, 0x07
-};
-// 'trainer_right_standing', 16x16px
-const unsigned char trainer_right_standing [32] = {
-	0xc0, 0x0f, 0x20, 0x10, 0x10, 0x20, 0x10, 0x3c, 0x10, 0x42, 0xf0, 0x3f, 0xf0, 0x29, 0x30, 0x29, 
-	0x30, 0x20, 0xe0, 0x10, 0x90, 0x0f, 0x90, 0x0f, 0x90, 0x04, 0xe0, 0x0c, 0x40, 0x1f, 0x80, 0x0f
-};
-// 'trainer_right_walking', 16x16px
-const unsigned char trainer_right_walking [32] = {
-	0x00, 0x00, 0xc0, 0x0f, 0x20, 0x10, 0x10, 0x20, 0x10, 0x3c, 0x10, 0x42, 0xf0, 0x3f, 0xf0, 0x29, 
-	0x30, 0x29, 0x30, 0x20, 0xe0, 0x10, 0xd0, 0x0f, 0x30, 0x19, 0x28, 0x25, 0xc8, 0x13, 0x30, 0x0c
-};
\ No newline at end of file
@@ -0,0 +1,50 @@
+#include "stack_watermark.h"
+
+#ifdef FURI_DEBUG
+
+#include <furi.h>
+
+#define STACK_PAINT_PATTERN 0xA5
+#define STACK_PAINT_GUARD   96 // Left untouched below base: begin's and end's own frames
+#define STACK_PAINT_MAX     4096
+
+// The scan relies on these staying real calls with their own frames
+__attribute__((noinline)) void stack_probe_begin(StackProbe* probe) {
+    volatile uint8_t marker = 0;
+    uint8_t* sp = (uint8_t*)&marker;
+
+    // The thread never went deeper than its lifetime minimum of free stack,
+    // so that much below the current frame is guaranteed to be ours
+    size_t free_space = furi_thread_get_stack_space(furi_thread_get_current_id());
+    probe->base = sp;
+    probe->paint_size = 0;
+    if(free_space <= STACK_PAINT_GUARD * 2) return;
+
+    size_t size = free_space - STACK_PAINT_GUARD * 2;
+    if(size > STACK_PAINT_MAX) size = STACK_PAINT_MAX;
+    volatile uint8_t* p = sp - STACK_PAINT_GUARD - size;
+    probe->painted = (uint8_t*)p;
+    probe->paint_size = size;
+    for(size_t i = 0; i < size; i++) p[i] = STACK_PAINT_PATTERN;
+}
+
+__attribute__((noinline)) void stack_probe_end(StackProbe* probe) {
+    if(probe->paint_size == 0) return;
+
+    // Stack grows down: the first dirty byte from the bottom is the deepest use
+    volatile const uint8_t* p = probe->painted;
+    size_t clean = 0;
+    while(clean < probe->paint_size && p[clean] == STACK_PAINT_PATTERN) clean++;
+
+    uint32_t used = (uint32_t)(probe->base - (probe->painted + clean));
+    probe->runs++;
+    if(used > probe->peak) probe->peak = used;
+    if(clean == 0) FURI_LOG_W("Stack", "Probe ran past the painted area, peak is a lower bound");
+}
+
+void stack_probe_log(const StackProbe* probe, const char* name) {
+    if(probe->runs == 0) return;
+    FURI_LOG_I("Stack", "%s peak %lu bytes over %lu runs", name, probe->peak, probe->runs);
+}
+
+#endif // FURI_DEBUG
@@ -0,0 +1,44 @@
+// stack_watermark.h - Peak stack usage per code path, debug builds only
+#ifndef STACK_WATERMARK_H
+#define STACK_WATERMARK_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// One probe per code path. begin paints the free stack below the caller
+// with a pattern, end finds the deepest byte that was overwritten. Probes
+// must not nest on the same thread, the inner one would repaint the outer
+// one's marks. Different threads (game loop, GUI draw) are fine.
+typedef struct {
+    uint8_t* base;     // Stack pointer at begin
+    uint8_t* painted;  // Lowest painted byte
+    size_t paint_size;
+    uint32_t peak;     // Deepest use below the probe point so far, in bytes
+    uint32_t runs;
+} StackProbe;
+
+#ifdef FURI_DEBUG
+
+void stack_probe_begin(StackProbe* probe);
+void stack_probe_end(StackProbe* probe);
+void stack_probe_log(const StackProbe* probe, const char* name);
+
+// Run call under a probe, in release builds just run it
+#define STACK_PROBE_CALL(probe, call)   \
+    do {                                \
+        StackProbe* probe_ = (probe);   \
+        stack_probe_begin(probe_);      \
+        call;                           \
+        stack_probe_end(probe_);        \
+    } while(0)
+
+#else
+
+#define STACK_PROBE_CALL(probe, call) \
+    do {                              \
+        call;                         \
+    } while(0)
+
+#endif // FURI_DEBUG
+
+#endif // STACK_WATERMARK_H
@@ -0,0 +1,73 @@
+#include "text.h"
+
+// Canonical Huffman: codes of one length are consecutive, so a code is
+// known once it falls below the first code of its length plus their count.
+static uint8_t decode_symbol(const uint8_t* bits, uint32_t* pos) {
+    int code = 0;
+    int first = 0;
+    int index = 0;
+
+    for(int len = 1; len <= TEXT_MAX_BITS; len++) {
+        code |= (bits[*pos >> 3] >> (7 - (*pos & 7))) & 1;
+        (*pos)++;
+        int count = text_huffman_counts[len];
+        if(code - first < count) return text_huffman_symbols[index + code - first];
+        index += count;
+        first = (first + count) << 1;
+        code <<= 1;
+    }
+    return 0; // Not a code, ends the string
+}
+
+size_t text_decode(uint16_t id, char* out, size_t size) {
+    if(size == 0) return 0;
+    if(id >= TEXT_COUNT) {
+        out[0] = '\0';
+        return 0;
+    }
+
+    uint32_t pos = text_offsets[id] * 8u;
+    size_t length = 0;
+    uint8_t symbol;
+    while((symbol = decode_symbol(text_bits, &pos)) != 0 && length + 1 < size) {
+        out[length++] = (char)symbol;
+    }
+    out[length] = '\0';
+    return length;
+}
+
+void text_cache_clear(TextCache* cache) {
+    cache->count = 0;
+}
+
+static int find_slot(const TextCache* cache, uint16_t id) {
+    for(int i = 0; i < cache->count; i++) {
+        if(cache->ids[i] == id) return i;
+    }
+    return -1;
+}
+
+bool text_cache_load(TextCache* cache, uint16_t id) {
+    if(find_slot(cache, id) >= 0) return true;
+    if(cache->count == TEXT_CACHE_SLOTS) return false;
+
+    // Decode one past the slot to tell a string that fits from a cut one
+    char text[TEXT_CACHE_LEN + 1];
+    if(text_decode(id, text, sizeof(text)) >= TEXT_CACHE_LEN) return false;
+
+    for(size_t i = 0; i < TEXT_CACHE_LEN; i++) {
+        cache->text[cache->count][i] = text[i];
+        if(text[i] == '\0') break;
+    }
+    // Publish the id last, the draw callback may be looking
+    cache->ids[cache->count] = id;
+    cache->count++;
+    return true;
+}
+
+const char* text_get(const TextCache* cache, uint16_t id, char* buf, size_t size) {
+    int slot = find_slot(cache, id);
+    if(slot >= 0) return cache->text[slot];
+    text_decode(id, buf, size);
+    return buf;
+}
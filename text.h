@@ -0,0 +1,36 @@
+// text.h - Game text from the Huffman coded pool in text_data.c
+#ifndef TEXT_H
+#define TEXT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "text_data.h"
+
+#define TEXT_CACHE_SLOTS 16
+#define TEXT_CACHE_LEN   16 // Longest cached string including the terminator
+#define TEXT_BUFFER_SIZE (TEXT_MAX_LEN + 1) // Holds any string uncut
+
+// Expand one string into out, cut to fit and always terminated. Returns
+// the number of characters written.
+size_t text_decode(uint16_t id, char* out, size_t size);
+
+// Decoded strings of the current battle (names, moves). Filled on the game
+// thread when a battle opens and only read by the draw callback, cleared
+// with the scene.
+typedef struct {
+    uint16_t ids[TEXT_CACHE_SLOTS];
+    char text[TEXT_CACHE_SLOTS][TEXT_CACHE_LEN];
+    uint8_t count;
+} TextCache;
+
+void text_cache_clear(TextCache* cache);
+
+// Decode a short string into the cache, false if it is full or the string
+// does not fit a slot
+bool text_cache_load(TextCache* cache, uint16_t id);
+
+// The cached string, or the string decoded into buf when it is not cached
+const char* text_get(const TextCache* cache, uint16_t id, char* buf, size_t size);
+
+#endif // TEXT_H
@@ -0,0 +1,67 @@
+// text_data.c - Generated by tools/gen_text.py, do not edit
+#include "text_data.h"
+
+// Codes of each length
+const uint8_t text_huffman_counts[TEXT_MAX_BITS + 1] = {0, 0, 0, 0, 8, 8, 8, 9, 14, 0, 0, 0, 0, 0, 0, 0};
+
+// Symbols in code order
+const uint8_t text_huffman_symbols[] = {
+    0x00, 0x20, 0x61, 0x65, 0x69, 0x72, 0x73, 0x74, 0x21, 0x62, 0x63, 0x68,
+    0x6c, 0x6e, 0x6f, 0x75, 0x64, 0x66, 0x67, 0x6b, 0x6d, 0x70, 0x77, 0x79,
+    0x2e, 0x3f, 0x41, 0x47, 0x50, 0x53, 0x54, 0x57, 0x7a, 0x27, 0x42, 0x43,
+    0x45, 0x46, 0x49, 0x4c, 0x51, 0x52, 0x56, 0x59, 0x5a, 0x71, 0x76,
+};
+
+// Byte offset of each string in text_bits
+const uint16_t text_offsets[TEXT_COUNT] = {
+    [TEXT_BULBASAUR] = 0,
+    [TEXT_CHARMANDER] = 6,
+    [TEXT_SQUIRTLE] = 13,
+    [TEXT_PIDGEY] = 19,
+    [TEXT_ZUBAT] = 24,
+    [TEXT_UNKNOWN] = 28,
+    [TEXT_TACKLE] = 32,
+    [TEXT_SCRATCH] = 37,
+    [TEXT_QUICK_ATTACK] = 42,
+    [TEXT_GROWL] = 51,
+    [TEXT_EMBER] = 55,
+    [TEXT_FLAMETHROWER] = 59,
+    [TEXT_WATER_GUN] = 67,
+    [TEXT_BUBBLE] = 73,
+    [TEXT_VINE_WHIP] = 78,
+    [TEXT_RAZOR_LEAF] = 85,
+    [TEXT_GUST] = 93,
+    [TEXT_WING_ATTACK] = 96,
+    [TEXT_POISON_STING] = 104,
+    [TEXT_ACID] = 112,
+    [TEXT_THUNDER_SHOCK] = 116,
+    [TEXT_YOUNGSTER_TIM] = 125,
+    [TEXT_BURNED] = 134,
+    [TEXT_PARALYZED] = 141,
+    [TEXT_ASLEEP] = 150,
+    [TEXT_POISONED] = 158,
+    [TEXT_NO_EFFECT] = 167,
+    [TEXT_FAST_ASLEEP] = 180,
+    [TEXT_WOKE_UP] = 189,
+    [TEXT_FULLY_PARALYZED] = 195,
+    [TEXT_HURT_BY_BURN] = 203,
+    [TEXT_HURT_BY_POISON] = 215,
+};
+
+const uint8_t text_bits[] = {
+    0xf3, 0xbd, 0x22, 0x4c, 0x57, 0x50, 0xf4, 0x99, 0x2e, 0x85, 0x5c, 0x0d, 0x40, 0xeb, 0xfd, 0x74,
+    0x57, 0xa1, 0x80, 0xe8, 0x98, 0x64, 0x7b, 0x80, 0xfd, 0xbc, 0x49, 0xc0, 0xe3, 0xc7, 0x88, 0x00,
+    0xec, 0x52, 0xce, 0x86, 0x00, 0xeb, 0x25, 0x27, 0x94, 0xc0, 0xf9, 0xba, 0x4b, 0x31, 0xe4, 0xee,
+    0x52, 0xcc, 0x00, 0xe6, 0xb6, 0xda, 0x80, 0xf5, 0xd2, 0x26, 0xa0, 0xf6, 0xa1, 0x68, 0x6f, 0x35,
+    0xb6, 0xc6, 0xa0, 0xee, 0x4e, 0x6a, 0x3c, 0xef, 0x50, 0xf3, 0xbc, 0x63, 0x43, 0x00, 0xfb, 0x4a,
+    0x98, 0xf7, 0x9a, 0x6a, 0x00, 0xfa, 0x2f, 0x16, 0x51, 0xf8, 0x32, 0xc4, 0x00, 0xe7, 0x76, 0x70,
+    0xee, 0x95, 0xc8, 0x79, 0x3b, 0x94, 0xb3, 0x00, 0xe9, 0x64, 0x6b, 0x54, 0x7a, 0xba, 0x57, 0x20,
+    0xe5, 0x24, 0xc0, 0x00, 0xed, 0x3b, 0xd7, 0x03, 0x51, 0xeb, 0x3b, 0x4b, 0x30, 0xfc, 0xb5, 0xeb,
+    0x93, 0x39, 0xa8, 0xf6, 0x4d, 0x00, 0xd8, 0x98, 0x63, 0x75, 0xa9, 0xe1, 0x00, 0x46, 0x1d, 0x49,
+    0x4a, 0x9b, 0xf8, 0x3c, 0x20, 0x00, 0xc4, 0xe9, 0x41, 0x26, 0xa1, 0x9e, 0xb0, 0x00, 0xd8, 0x98,
+    0x75, 0xb2, 0x35, 0xaa, 0x78, 0x40, 0x00, 0xf7, 0x71, 0x99, 0x60, 0x35, 0xb0, 0x9e, 0x38, 0x9c,
+    0x9f, 0x87, 0x0e, 0x00, 0x46, 0x1c, 0x49, 0x9c, 0x49, 0xa8, 0x67, 0xac, 0x00, 0xda, 0xd9, 0x98,
+    0xdf, 0x58, 0x00, 0x91, 0x57, 0xc9, 0xc7, 0x4b, 0x7f, 0x9c, 0x00, 0x46, 0x19, 0xdd, 0x5c, 0x63,
+    0xb8, 0xa3, 0xb0, 0xc6, 0xeb, 0x58, 0x00, 0x46, 0x19, 0xdd, 0x5c, 0x63, 0xb8, 0xeb, 0x64, 0x6b,
+    0x56, 0x00,
+};
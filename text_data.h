@@ -0,0 +1,53 @@
+// text_data.h - Generated by tools/gen_text.py, do not edit
+// 32 strings: text 351 -> 226 bytes (64%), with tables 479 -> 353 bytes
+#ifndef TEXT_DATA_H
+#define TEXT_DATA_H
+
+#include <stdint.h>
+
+#define TEXT_MAX_BITS 15
+#define TEXT_MAX_LEN  20 // Longest string without the terminator
+#define TEXT_LONGEST  TEXT_HURT_BY_BURN
+
+typedef enum {
+    TEXT_BULBASAUR,
+    TEXT_CHARMANDER,
+    TEXT_SQUIRTLE,
+    TEXT_PIDGEY,
+    TEXT_ZUBAT,
+    TEXT_UNKNOWN,
+    TEXT_TACKLE,
+    TEXT_SCRATCH,
+    TEXT_QUICK_ATTACK,
+    TEXT_GROWL,
+    TEXT_EMBER,
+    TEXT_FLAMETHROWER,
+    TEXT_WATER_GUN,
+    TEXT_BUBBLE,
+    TEXT_VINE_WHIP,
+    TEXT_RAZOR_LEAF,
+    TEXT_GUST,
+    TEXT_WING_ATTACK,
+    TEXT_POISON_STING,
+    TEXT_ACID,
+    TEXT_THUNDER_SHOCK,
+    TEXT_YOUNGSTER_TIM,
+    TEXT_BURNED,
+    TEXT_PARALYZED,
+    TEXT_ASLEEP,
+    TEXT_POISONED,
+    TEXT_NO_EFFECT,
+    TEXT_FAST_ASLEEP,
+    TEXT_WOKE_UP,
+    TEXT_FULLY_PARALYZED,
+    TEXT_HURT_BY_BURN,
+    TEXT_HURT_BY_POISON,
+    TEXT_COUNT
+} TextId;
+
+extern const uint8_t text_huffman_counts[TEXT_MAX_BITS + 1];
+extern const uint8_t text_huffman_symbols[];
+extern const uint16_t text_offsets[TEXT_COUNT];
+extern const uint8_t text_bits[];
+
+#endif // TEXT_DATA_H
@@ -0,0 +1,9 @@
+#include "tiles.h"
+
+// The one definition of the table. tiles.h only declares it, so any number
+// of files can include the header without defining it twice.
+const TileDef tile_defs[TILE_COUNT] = {
+    [TILE_GRASS] = {ASSET_TILE_GRASS, false, true},
+    [TILE_BORDER] = {ASSET_TILE_GRASS, true, false},
+    [TILE_FENCE] = {ASSET_TILE_FENCE_TOP_BOTTOM, true, false},
+};
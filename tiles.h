@@ -1,49 +1,26 @@
-#include <stdlib.h>  // For rand()
-#include "pokemon.h"
-#define TILE_TYPE_GRASS                     0
-#define TILE_TYPE_CAVE                      1
-#define TILE_TYPE_WATER                     2
-#define TILE_TYPE_GRASS_BORDER_TOP          3
-
-
-
-// Struct for encounter data
-typedef struct {
-    int spawn_rate;  // Percentage (0-100) chance to encounter
-    int pokemon[3];  // Up to 3 Pokémon can spawn here
-    int min_level;
-    int max_level;
-} TileSpawnData;
-
-// Struct for each tile
+// tiles.h - Map tile IDs and how each one looks and behaves
+#ifndef TILES_H
+#define TILES_H
+
+#include <stdbool.h>
+#include "assets.h"
+
+// Tile IDs, maps store one byte per cell
+typedef enum {
+    TILE_GRASS,  // Walkable tall grass, uses the map's encounter zone
+    TILE_BORDER, // Solid edge drawn as grass
+    TILE_FENCE,  // Solid fence along the top and bottom edges
+    TILE_COUNT
+} TileId;
+
+// What a tile ID looks like and how it behaves
 typedef struct {
-    int x;
-    int y;
+    AssetId sprite; // 16x16
     bool is_obstacle;
-    int type;  // Tile type (Grass, Cave, Water)
-    TileSpawnData spawn_data;
-    int transition_map_index;
-} Tile;
-
-
-
-
-TileSpawnData GRASS_PEWTER = { 30, {POKEMON_BULBASAUR, POKEMON_PIDGEY, POKEMON_CHARMANDER}, 3, 7 };
-
-// 'grass', 16x16px
-const unsigned char grass [] = {
-	0x00, 0x00, 0x62, 0xc4, 0x55, 0xaa, 0x49, 0x92, 0x29, 0x52, 0x33, 0x66, 0x1e, 0x3c, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x62, 0xc4, 0x55, 0xaa, 0x49, 0x92, 0x29, 0x52, 0x33, 0x66, 0x1e, 0x3c
-};
+    bool has_encounters;
+} TileDef;
 
-// 'grass_border_top', 16x16px
-const unsigned char grass_border_top [] = {
-	0xff, 0xff, 0x5d, 0xae, 0x55, 0xaa, 0x75, 0xba, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0x62, 0xc4, 
-	0x55, 0xaa, 0x49, 0x92, 0x29, 0x52, 0x33, 0x66, 0x1e, 0x3c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};
+// Indexed by TileId
+extern const TileDef tile_defs[TILE_COUNT];
 
-// 'fence_top_bottom', 16x16px
-const unsigned char fence_top_bottom [] = {
-	0x08, 0x10, 0x1c, 0x38, 0x36, 0x6c, 0x22, 0x44, 0x41, 0x82, 0x49, 0x92, 0xc1, 0x83, 0x41, 0x82, 
-	0xc1, 0x83, 0x41, 0x82, 0x41, 0x82, 0xc1, 0x83, 0x49, 0x92, 0xc1, 0x83, 0x41, 0x82, 0x7f, 0xfe
-};
\ No newline at end of file
+#endif // TILES_H
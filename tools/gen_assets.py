@@ -0,0 +1,252 @@
+#!/usr/bin/env python3
+"""Pack every PNG in images/ into one deduplicated sprite bundle.
+
+Each image becomes a masked sprite. Dark pixels are set. The mask marks the
+opaque pixels: taken from the alpha channel (or tRNS) when the image has one,
+otherwise every white pixel that can be reached from the image border through
+other white pixels is transparent and the rest, including the white inside an
+outline, is opaque.
+
+Sprites are cut into 8x8 cells stored like the display buffer: 8 columns of
+(bits, mask) byte pairs with the top row in bit 0. Identical cells, common in
+tiles and animation frames, are stored once in a shared pool, and so are
+cells that are mirror images of each other (left and right facing frames).
+Each sprite is a list of cell numbers, page by page.
+
+Asset IDs are kept stable in tools/asset_ids.txt: new images are appended,
+so adding art only means dropping a PNG into images/ and rerunning. Reference
+art in images/source/ is not packed.
+
+Usage: python3 tools/gen_assets.py   (rewrites asset_data.c/.h)
+"""
+import os
+import struct
+import zlib
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+IMAGES = os.path.join(ROOT, "images")
+ID_FILE = os.path.join(ROOT, "tools", "asset_ids.txt")
+CELL = 8
+MIRRORED = 0x8000  # Cell number flag, see masked_sprite.h
+
+
+def paeth(a, b, c):
+    p = a + b - c
+    pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+    if pa <= pb and pa <= pc:
+        return a
+    return b if pb <= pc else c
+
+
+def read_png(path):
+    """Decode a non-interlaced PNG into rows of (r, g, b, a) and whether it has transparency."""
+    data = open(path, "rb").read()
+    assert data[:8] == b"\x89PNG\r\n\x1a\n", path + " is not a PNG"
+    pos = 8
+    idat = b""
+    palette = None
+    trns = None
+    while pos < len(data):
+        length, kind = struct.unpack(">I4s", data[pos:pos + 8])
+        body = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b"IHDR":
+            width, height, depth, color, _, _, interlace = struct.unpack(">IIBBBBB", body)
+        elif kind == b"PLTE":
+            palette = [tuple(body[i:i + 3]) for i in range(0, len(body), 3)]
+        elif kind == b"tRNS":
+            trns = body
+        elif kind == b"IDAT":
+            idat += body
+    assert interlace == 0, path + ": interlaced PNGs are not supported"
+    assert depth <= 8, path + ": 16 bit PNGs are not supported"
+
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[color]
+    bpp = max(1, channels * depth // 8)
+    stride = (width * channels * depth + 7) // 8
+    raw = zlib.decompress(idat)
+
+    rows = []
+    prev = bytearray(stride)
+    for y in range(height):
+        kind = raw[y * (stride + 1)]
+        line = bytearray(raw[y * (stride + 1) + 1:(y + 1) * (stride + 1)])
+        for i in range(stride):
+            a = line[i - bpp] if i >= bpp else 0
+            b = prev[i]
+            c = prev[i - bpp] if i >= bpp else 0
+            line[i] = (line[i] + (0, a, b, (a + b) // 2, paeth(a, b, c))[kind]) & 0xFF
+        prev = line
+
+        # Unpack samples, scaling sub-byte depths up to 0..255 except palette indices
+        samples = []
+        for i in range(width * channels):
+            if depth == 8:
+                samples.append(line[i])
+            else:
+                bit = i * depth
+                value = (line[bit // 8] >> (8 - depth - bit % 8)) & ((1 << depth) - 1)
+                samples.append(value if color == 3 else value * 255 // ((1 << depth) - 1))
+
+        pixels = []
+        for x in range(width):
+            s = samples[x * channels:(x + 1) * channels]
+            if color == 3:
+                r, g, b = palette[s[0]]
+                alpha = trns[s[0]] if trns and s[0] < len(trns) else 255
+            elif color == 0:
+                r = g = b = s[0]
+                alpha = 0 if trns and s[0] == struct.unpack(">H", trns[:2])[0] * 255 // ((1 << depth) - 1) else 255
+            elif color == 2:
+                r, g, b = s
+                alpha = 255
+                if trns and (r, g, b) == struct.unpack(">HHH", trns[:6]):
+                    alpha = 0
+            elif color == 4:
+                r = g = b = s[0]
+                alpha = s[1]
+            else:
+                r, g, b, alpha = s
+            pixels.append((r, g, b, alpha))
+        rows.append(pixels)
+
+    has_alpha = color in (4, 6) or trns is not None
+    return width, height, rows, has_alpha
+
+
+def sprite_bits(path):
+    """Return width, height, set[y][x] and opaque[y][x] for an image."""
+    width, height, rows, has_alpha = read_png(path)
+    dark = [[(r * 299 + g * 587 + b * 114) // 1000 < 128 for r, g, b, _ in row] for row in rows]
+
+    if has_alpha:
+        opaque = [[a >= 128 for _, _, _, a in row] for row in rows]
+        bits = [[dark[y][x] and opaque[y][x] for x in range(width)] for y in range(height)]
+        return width, height, bits, opaque
+
+    # Flood the white background in from the border
+    outside = [[False] * width for _ in range(height)]
+    stack = [(x, y) for x in range(width) for y in (0, height - 1)]
+    stack += [(x, y) for y in range(height) for x in (0, width - 1)]
+    while stack:
+        x, y = stack.pop()
+        if not (0 <= x < width and 0 <= y < height) or outside[y][x] or dark[y][x]:
+            continue
+        outside[y][x] = True
+        stack += [(x + 1, y), (x - 1, y), (x, y + 1), (x, y - 1)]
+
+    opaque = [[not outside[y][x] for x in range(width)] for y in range(height)]
+    return width, height, dark, opaque
+
+
+def cells(width, height, bits, opaque):
+    """8x8 cells page by page, each 16 bytes of interleaved (bits, mask) columns."""
+    out = []
+    for page in range((height + CELL - 1) // CELL):
+        for left in range(0, width, CELL):
+            cell = []
+            for x in range(left, left + CELL):
+                b = m = 0
+                for row in range(CELL):
+                    y = page * CELL + row
+                    if x < width and y < height:
+                        b |= bits[y][x] << row
+                        m |= opaque[y][x] << row
+                cell += [b, m]
+            out.append(bytes(cell))
+    return out
+
+
+def mirror(cell):
+    return b"".join(cell[x * 2:x * 2 + 2] for x in reversed(range(CELL)))
+
+
+def asset_ids():
+    """Names in ID order. Known names keep their place, new images go last."""
+    names = []
+    if os.path.exists(ID_FILE):
+        names = [line.strip() for line in open(ID_FILE) if line.strip() and not line.startswith("#")]
+    images = sorted(f[:-4] for f in os.listdir(IMAGES) if f.endswith(".png"))
+    missing = [n for n in names if n not in images]
+    assert not missing, "no image for %s, remove it from %s" % (", ".join(missing), ID_FILE)
+    added = [n for n in images if n not in names]
+    if added:
+        with open(ID_FILE, "a") as f:
+            if not names:
+                f.write("# Asset IDs in order, appended to by tools/gen_assets.py. Do not reorder.\n")
+            f.write("".join(n + "\n" for n in added))
+    return names + added
+
+
+def main():
+    pool = []
+    pool_index = {}
+    index = []
+    sprites = []
+    raw_size = 0
+
+    for name in asset_ids():
+        width, height, bits, opaque = sprite_bits(os.path.join(IMAGES, name + ".png"))
+        assert width < 256 and height < 256, name + " is too large"
+        first = len(index)
+        for cell in cells(width, height, bits, opaque):
+            if cell in pool_index:
+                index.append(pool_index[cell])
+            elif mirror(cell) in pool_index:
+                index.append(pool_index[mirror(cell)] | MIRRORED)
+            else:
+                pool_index[cell] = len(pool)
+                pool.append(cell)
+                index.append(pool_index[cell])
+        sprites.append((name, width, height, first))
+        raw_size += width * ((height + 7) // 8) * 2
+    assert len(pool) < MIRRORED, "too many cells"
+
+    header = [
+        "// asset_data.h - Generated by tools/gen_assets.py, do not edit",
+        "#ifndef ASSET_DATA_H",
+        "#define ASSET_DATA_H",
+        "",
+        '#include "masked_sprite.h"',
+        "",
+        "// IDs are stable, see tools/asset_ids.txt",
+        "typedef enum {",
+    ]
+    header += ["    ASSET_%s, // %dx%d" % (name.upper(), w, h) for name, w, h, _ in sprites]
+    header += [
+        "    ASSET_COUNT",
+        "} AssetId;",
+        "",
+        "extern const MaskedSprite asset_sprites[ASSET_COUNT];",
+        "",
+        "#endif // ASSET_DATA_H",
+        "",
+    ]
+
+    packed_size = len(pool) * CELL * 2 + len(index) * 2
+    source = [
+        "// asset_data.c - Generated by tools/gen_assets.py, do not edit",
+        "// %d sprites, %d cells (%d unique), %d bytes packed vs %d unpacked" % (
+            len(sprites), len(index), len(pool), packed_size, raw_size),
+        '#include "asset_data.h"',
+        "",
+        "static const uint8_t asset_cells[%d * MASKED_SPRITE_CELL_BYTES] = {" % len(pool),
+    ]
+    source += ["    " + ", ".join("0x%02x" % v for v in cell) + "," for cell in pool]
+    source += ["};", "", "static const uint16_t asset_cell_index[%d] = {" % len(index)]
+    for i in range(0, len(index), 16):
+        source.append("    " + ", ".join("0x%04x" % v for v in index[i:i + 16]) + ",")
+    source += ["};", "", "const MaskedSprite asset_sprites[ASSET_COUNT] = {"]
+    source += ["    [ASSET_%s] = {%d, %d, asset_cell_index + %d, asset_cells}," % (name.upper(), w, h, first)
+               for name, w, h, first in sprites]
+    source += ["};", ""]
+
+    with open(os.path.join(ROOT, "asset_data.h"), "w") as f:
+        f.write("\n".join(header))
+    with open(os.path.join(ROOT, "asset_data.c"), "w") as f:
+        f.write("\n".join(source))
+    print(source[1][3:])
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+"""Generate the flash-resident encounter zone tables.
+
+Each zone lists weighted species with their own level ranges. The weights are
+turned into a Vose alias table here so the game can pick a species in O(1)
+with one random column and one biased coin.
+
+Usage: python3 tools/gen_encounters.py   (rewrites encounter_data.c/.h)
+"""
+import os
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+# name, encounter rate (percent per step), [(species, weight, min_level, max_level)]
+ZONES = [
+    ("ROUTE_1_GRASS", 30, [
+        ("POKEMON_BULBASAUR", 1, 3, 7),
+        ("POKEMON_PIDGEY", 1, 3, 7),
+        ("POKEMON_CHARMANDER", 1, 3, 7),
+    ]),
+    ("PALLET_TOWN_GRASS", 30, [
+        ("POKEMON_BULBASAUR", 1, 3, 7),
+        ("POKEMON_PIDGEY", 1, 3, 7),
+        ("POKEMON_CHARMANDER", 1, 3, 7),
+    ]),
+]
+
+COIN_SCALE = 256  # Coin flips are one random byte
+
+
+def alias_table(weights):
+    """Vose's alias method with integer thresholds out of COIN_SCALE."""
+    n = len(weights)
+    total = sum(weights)
+    # Scale so each column holds exactly COIN_SCALE units of probability mass
+    scaled = [w * n * COIN_SCALE for w in weights]
+    threshold = [COIN_SCALE] * n
+    alias = list(range(n))
+    small = [i for i, p in enumerate(scaled) if p < total * COIN_SCALE]
+    large = [i for i, p in enumerate(scaled) if p >= total * COIN_SCALE]
+    while small and large:
+        s = small.pop()
+        l = large.pop()
+        threshold[s] = scaled[s] // total
+        alias[s] = l
+        scaled[l] -= total * COIN_SCALE - scaled[s]
+        (small if scaled[l] < total * COIN_SCALE else large).append(l)
+    # Whatever is left keeps its own column; a threshold of 255 plus a self
+    # alias selects the column on every coin value.
+    return [min(t, COIN_SCALE - 1) for t in threshold], alias
+
+
+def main():
+    assert len(ZONES) < 16, "Zone IDs must fit the 4 bit encounter nibble"
+
+    header = [
+        "// encounter_data.h - Generated by tools/gen_encounters.py, do not edit",
+        "#ifndef ENCOUNTER_DATA_H",
+        "#define ENCOUNTER_DATA_H",
+        "",
+        "// Encounter zone IDs as stored in the map's zone nibbles",
+        "typedef enum {",
+        "    ENCOUNTER_ZONE_NONE,",
+    ]
+    header += ["    ENCOUNTER_ZONE_%s," % name for name, _, _ in ZONES]
+    header += [
+        "    ENCOUNTER_ZONE_COUNT",
+        "} EncounterZoneId;",
+        "",
+        "#endif // ENCOUNTER_DATA_H",
+        "",
+    ]
+
+    source = [
+        "// encounter_data.c - Generated by tools/gen_encounters.py, do not edit",
+        '#include "encounters.h"',
+        "",
+    ]
+    entries = ["    [ENCOUNTER_ZONE_NONE] = {0, 0, NULL, NULL, NULL},"]
+    for name, rate, slots in ZONES:
+        lower = name.lower()
+        threshold, alias = alias_table([weight for _, weight, _, _ in slots])
+        source.append("static const EncounterSlot %s_slots[] = {" % lower)
+        for (species, weight, min_level, max_level) in slots:
+            source.append("    {%s, %d, %d}, // weight %d" % (species, min_level, max_level - min_level + 1, weight))
+        source.append("};")
+        source.append("static const uint8_t %s_threshold[] = {%s};" % (lower, ", ".join(map(str, threshold))))
+        source.append("static const uint8_t %s_alias[] = {%s};" % (lower, ", ".join(map(str, alias))))
+        source.append("")
+        entries.append("    [ENCOUNTER_ZONE_%s] = {%d, %d, %s_slots, %s_threshold, %s_alias}," % (name, rate, len(slots), lower, lower, lower))
+
+    source.append("const EncounterZone encounter_zones[ENCOUNTER_ZONE_COUNT] = {")
+    source += entries
+    source.append("};")
+    source.append("")
+
+    with open(os.path.join(ROOT, "encounter_data.h"), "w") as f:
+        f.write("\n".join(header))
+    with open(os.path.join(ROOT, "encounter_data.c"), "w") as f:
+        f.write("\n".join(source))
+
+
+if __name__ == "__main__":
+    main()
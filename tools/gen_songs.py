@@ -0,0 +1,144 @@
+#!/usr/bin/env python3
+"""Generate the music and sound effect note streams.
+
+Songs are written as rows of a one-voice tracker: a note such as C5 or F#4,
+"-" to hold the previous row and "." to rest. Every row lasts row_ms
+milliseconds, held rows add up into one note. Lengths are stored in
+sequencer ticks, read from SEQUENCER_HZ in sequencer.h, and a row has to be
+a whole number of them. The streams use the byte format described in
+sequencer.h.
+
+Usage: python3 tools/gen_songs.py   (rewrites song_data.c/.h)
+"""
+import os
+import re
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+REST = 0x00
+NOTE_MAX = 0x5F
+OP_LENGTH = 0x80
+LENGTH_MAX = 0x3F
+OP_LOOP = 0xFE
+OP_END = 0xFF
+
+NOTE_NAMES = {"C": 0, "D": 2, "E": 4, "F": 5, "G": 7, "A": 9, "B": 11}
+
+# (ID, priority, row_ms, loops, rows). IDs become SONG_<ID>; music has
+# priority 0, sound effects interrupt sound effects of lower priority.
+SONGS = [
+    ("OVERWORLD", 0, 200, True, """
+        C5 -  E5 G5 A5 -  G5 E5 | F5 -  A5 -  G5 -  .  .
+        E5 -  G5 C6 B5 -  G5 E5 | D5 -  G4 -  C5 -  -  .
+        C5 E5 G5 E5 A5 -  G5 -  | F5 E5 D5 E5 F5 -  A5 -
+        G5 -  E5 C5 D5 -  B4 -  | C5 -  -  -  .  .  .  .
+    """),
+    ("BATTLE", 0, 100, True, """
+        A4 A4 C5 A4 D5 A4 E5 A4 | F5 E5 D5 C5 B4 C5 D5 E5
+        A4 A4 C5 A4 D5 A4 E5 A4 | G5 F5 E5 D5 E5 -  -  -
+        F4 A4 C5 F5 E5 C5 A4 C5 | G4 B4 D5 G5 F5 D5 B4 D5
+        A4 C5 E5 A5 G#5 - E5 -  | A5 -  .  -  E5 D5 C5 B4
+    """),
+    ("HIT", 2, 40, False, """
+        C6 G5 D5 A4 .
+    """),
+]
+
+
+def sequencer_hz():
+    with open(os.path.join(ROOT, "sequencer.h")) as f:
+        match = re.search(r"#define SEQUENCER_HZ\s+(\d+)", f.read())
+    assert match, "SEQUENCER_HZ not found in sequencer.h"
+    return int(match.group(1))
+
+
+def parse_note(token):
+    match = re.fullmatch(r"([A-G])(#?)(\d)", token)
+    assert match, "bad note %r" % token
+    semitone = (int(match.group(3)) - 2) * 12 + NOTE_NAMES[match.group(1)] + (1 if match.group(2) else 0)
+    assert 0 <= semitone < NOTE_MAX, "note %s out of range" % token
+    return semitone + 1
+
+
+def encode(row_ms, hz, loops, rows):
+    """Byte stream and note count of one song."""
+    assert row_ms * hz % 1000 == 0, "%d ms rows are not a whole number of %d Hz ticks" % (row_ms, hz)
+    row_ticks = row_ms * hz // 1000
+    events = []  # [value, rows]
+    for token in rows.replace("|", " ").split():
+        if token == "-":
+            assert events, "hold before the first note"
+            events[-1][1] += 1
+        else:
+            events.append([REST if token == "." else parse_note(token), 1])
+
+    data = bytearray()
+    length = None
+    for value, count in events:
+        ticks = count * row_ticks
+        assert ticks <= LENGTH_MAX, "note longer than %d ticks" % LENGTH_MAX
+        if ticks != length:
+            data.append(OP_LENGTH | ticks)
+            length = ticks
+        data.append(value)
+    data.append(OP_LOOP if loops else OP_END)
+    return data, sum(1 for value, _ in events if value != REST)
+
+
+def main():
+    ids = [s[0] for s in SONGS]
+    assert len(ids) == len(set(ids)), "duplicate song ID"
+
+    data = bytearray()
+    offsets = []
+    notes = 0
+    hz = sequencer_hz()
+    for _, _, row_ms, loops, rows in SONGS:
+        stream, count = encode(row_ms, hz, loops, rows)
+        offsets.append(len(data))
+        data += stream
+        notes += count
+    summary = "%d songs, %d notes in %d bytes" % (len(SONGS), notes, len(data))
+
+    header = [
+        "// song_data.h - Generated by tools/gen_songs.py, do not edit",
+        "// " + summary,
+        "#ifndef SONG_DATA_H",
+        "#define SONG_DATA_H",
+        "",
+        '#include "sequencer.h"',
+        "",
+        "typedef enum {",
+    ]
+    header += ["    SONG_%s," % i for i in ids]
+    header += [
+        "    SONG_COUNT",
+        "} SongId;",
+        "",
+        "extern const Song songs[SONG_COUNT];",
+        "",
+        "#endif // SONG_DATA_H",
+        "",
+    ]
+
+    source = [
+        "// song_data.c - Generated by tools/gen_songs.py, do not edit",
+        '#include "song_data.h"',
+        "",
+        "static const uint8_t song_bytes[] = {",
+    ]
+    for i in range(0, len(data), 16):
+        source.append("    " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+    source += ["};", "", "const Song songs[SONG_COUNT] = {"]
+    source += ["    [SONG_%s] = {song_bytes + %d, %d}," % (s[0], o, s[1]) for s, o in zip(SONGS, offsets)]
+    source += ["};", ""]
+
+    with open(os.path.join(ROOT, "song_data.h"), "w") as f:
+        f.write("\n".join(header))
+    with open(os.path.join(ROOT, "song_data.c"), "w") as f:
+        f.write("\n".join(source))
+    print(summary)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,180 @@
+#!/usr/bin/env python3
+"""Generate the compressed game text pool.
+
+Every string is Huffman coded with one static code built from the whole
+pool, terminated by a NUL symbol and started on a byte boundary so a 16 bit
+byte offset finds it. The code is canonical: the game only needs the number
+of codes of each length and the symbols in code order to decode.
+
+Usage: python3 tools/gen_text.py   (rewrites text_data.c/.h)
+"""
+import heapq
+import os
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+MAX_BITS = 15
+
+# (ID, text). IDs become TEXT_<ID>; append new strings, order does not matter.
+STRINGS = [
+    # Species, in PokemonSpecies order
+    ("BULBASAUR", "Bulbasaur"),
+    ("CHARMANDER", "Charmander"),
+    ("SQUIRTLE", "Squirtle"),
+    ("PIDGEY", "Pidgey"),
+    ("ZUBAT", "Zubat"),
+    ("UNKNOWN", "???"),
+    # Moves, in all_moves order
+    ("TACKLE", "Tackle"),
+    ("SCRATCH", "Scratch"),
+    ("QUICK_ATTACK", "Quick Attack"),
+    ("GROWL", "Growl"),
+    ("EMBER", "Ember"),
+    ("FLAMETHROWER", "Flamethrower"),
+    ("WATER_GUN", "Water Gun"),
+    ("BUBBLE", "Bubble"),
+    ("VINE_WHIP", "Vine Whip"),
+    ("RAZOR_LEAF", "Razor Leaf"),
+    ("GUST", "Gust"),
+    ("WING_ATTACK", "Wing Attack"),
+    ("POISON_STING", "Poison Sting"),
+    ("ACID", "Acid"),
+    ("THUNDER_SHOCK", "Thunder Shock"),
+    # Trainers
+    ("YOUNGSTER_TIM", "Youngster Tim"),
+    # Battle messages
+    ("BURNED", "was burned!"),
+    ("PARALYZED", "is paralyzed!"),
+    ("ASLEEP", "fell asleep!"),
+    ("POISONED", "was poisoned!"),
+    ("NO_EFFECT", "It had no effect..."),
+    ("FAST_ASLEEP", "is fast asleep!"),
+    ("WOKE_UP", "woke up!"),
+    ("FULLY_PARALYZED", "can't move!"),
+    ("HURT_BY_BURN", "is hurt by its burn!"),
+    ("HURT_BY_POISON", "is hurt by poison!"),
+]
+
+
+def huffman_lengths(freq):
+    """Code length per symbol."""
+    heap = [(count, i, [sym]) for i, (sym, count) in enumerate(sorted(freq.items()))]
+    heapq.heapify(heap)
+    lengths = {sym: 0 for sym in freq}
+    if len(heap) == 1:
+        lengths[heap[0][2][0]] = 1
+    tie = len(heap)
+    while len(heap) > 1:
+        a = heapq.heappop(heap)
+        b = heapq.heappop(heap)
+        for sym in a[2] + b[2]:
+            lengths[sym] += 1
+        heapq.heappush(heap, (a[0] + b[0], tie, a[2] + b[2]))
+        tie += 1
+    return lengths
+
+
+def canonical_codes(lengths):
+    """Codes assigned in (length, symbol) order, as the decoder expects."""
+    codes = {}
+    code = 0
+    prev = 0
+    for sym in sorted(lengths, key=lambda s: (lengths[s], s)):
+        code <<= lengths[sym] - prev
+        prev = lengths[sym]
+        codes[sym] = (code, lengths[sym])
+        code += 1
+    return codes
+
+
+def main():
+    ids = [i for i, _ in STRINGS]
+    assert len(ids) == len(set(ids)), "duplicate text ID"
+    texts = [t.encode("ascii") for _, t in STRINGS]
+
+    freq = {}
+    for text in texts:
+        for sym in text + b"\0":
+            freq[sym] = freq.get(sym, 0) + 1
+    lengths = huffman_lengths(freq)
+    assert max(lengths.values()) <= MAX_BITS, "code too long"
+    codes = canonical_codes(lengths)
+
+    data = bytearray()
+    offsets = []
+    for text in texts:
+        offsets.append(len(data))
+        bits = "".join(format(codes[sym][0], "0%db" % codes[sym][1]) for sym in text + b"\0")
+        bits += "0" * (-len(bits) % 8)
+        data += bytes(int(bits[i:i + 8], 2) for i in range(0, len(bits), 8))
+    assert len(data) < 65536, "pool too large for 16 bit offsets"
+
+    counts = [0] * (MAX_BITS + 1)
+    for sym in lengths:
+        counts[lengths[sym]] += 1
+    symbols = sorted(lengths, key=lambda s: (lengths[s], s))
+
+    longest = max(range(len(texts)), key=lambda i: len(texts[i]))
+    # Literals are compared with the 32 bit pointer that referenced each one,
+    # the pool with its 16 bit offsets and decoding tables
+    raw_size = sum(len(t) + 1 for t in texts)
+    packed_size = len(data) + len(offsets) * 2 + len(counts) + len(symbols)
+    summary = "%d strings: text %d -> %d bytes (%d%%), with tables %d -> %d bytes" % (
+        len(texts), raw_size, len(data), len(data) * 100 // raw_size, raw_size + len(texts) * 4, packed_size)
+
+    header = [
+        "// text_data.h - Generated by tools/gen_text.py, do not edit",
+        "// " + summary,
+        "#ifndef TEXT_DATA_H",
+        "#define TEXT_DATA_H",
+        "",
+        "#include <stdint.h>",
+        "",
+        "#define TEXT_MAX_BITS %d" % MAX_BITS,
+        "#define TEXT_MAX_LEN  %d // Longest string without the terminator" % len(texts[longest]),
+        "#define TEXT_LONGEST  TEXT_%s" % ids[longest],
+        "",
+        "typedef enum {",
+    ]
+    header += ["    TEXT_%s," % i for i in ids]
+    header += [
+        "    TEXT_COUNT",
+        "} TextId;",
+        "",
+        "extern const uint8_t text_huffman_counts[TEXT_MAX_BITS + 1];",
+        "extern const uint8_t text_huffman_symbols[];",
+        "extern const uint16_t text_offsets[TEXT_COUNT];",
+        "extern const uint8_t text_bits[];",
+        "",
+        "#endif // TEXT_DATA_H",
+        "",
+    ]
+
+    source = [
+        "// text_data.c - Generated by tools/gen_text.py, do not edit",
+        '#include "text_data.h"',
+        "",
+        "// Codes of each length",
+        "const uint8_t text_huffman_counts[TEXT_MAX_BITS + 1] = {%s};" % ", ".join(map(str, counts)),
+        "",
+        "// Symbols in code order",
+        "const uint8_t text_huffman_symbols[] = {",
+    ]
+    for i in range(0, len(symbols), 12):
+        source.append("    " + ", ".join("0x%02x" % s for s in symbols[i:i + 12]) + ",")
+    source += ["};", "", "// Byte offset of each string in text_bits", "const uint16_t text_offsets[TEXT_COUNT] = {"]
+    source += ["    [TEXT_%s] = %d," % (i, o) for i, o in zip(ids, offsets)]
+    source += ["};", "", "const uint8_t text_bits[] = {"]
+    for i in range(0, len(data), 16):
+        source.append("    " + ", ".join("0x%02x" % b for b in data[i:i + 16]) + ",")
+    source += ["};", ""]
+
+    with open(os.path.join(ROOT, "text_data.h"), "w") as f:
+        f.write("\n".join(header))
+    with open(os.path.join(ROOT, "text_data.c"), "w") as f:
+        f.write("\n".join(source))
+    print(summary)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,155 @@
+#!/usr/bin/env python3
+"""Compile map scripts (scripts/*.fms) into VM bytecode (assets/scripts/*.fsb).
+
+Source format, one instruction per line, '#' starts a comment:
+
+    const FLAG_INTRO 0          # named number
+    script on_enter             # next entry point, numbered in order
+    label:                      # jump target
+    dialog "Text\\nsecond line"
+    give_item POTION 2
+    move_npc 0 LEFT 3
+    battle PIDGEY 5
+    set_flag FLAG_INTRO / clear_flag FLAG_INTRO
+    if_flag FLAG_INTRO label    # jump if the flag is set
+    unless_flag FLAG_INTRO label
+    wait 30                     # logic ticks
+    jump label
+    end
+
+Arguments are pushed in order and consumed by the opcode, matching
+script_vm.h. Usage: python3 tools/script_compiler.py
+"""
+import glob
+import os
+import shlex
+import struct
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+
+OPS = {
+    "end": 0, "push8": 1, "push16": 2, "dialog": 3, "move_npc": 4, "give_item": 5,
+    "battle": 6, "set_flag": 7, "clear_flag": 8, "get_flag": 9, "jump": 10,
+    "jump_if_zero": 11, "wait": 12,
+}
+
+# Names shared with the C enums
+BUILTINS = {
+    "UP": 1, "RIGHT": 2, "DOWN": 3, "LEFT": 4,
+    "POTION": 0, "POKE_BALL": 1, "REPEL": 2,
+    "BULBASAUR": 0, "CHARMANDER": 1, "SQUIRTLE": 2, "PIDGEY": 3, "ZUBAT": 4,
+}
+
+# Instructions that push their arguments and then run one opcode
+SIMPLE = {
+    "dialog": 1, "move_npc": 3, "give_item": 2, "battle": 2,
+    "set_flag": 1, "clear_flag": 1, "wait": 1,
+}
+
+
+class Compiler:
+    def __init__(self, path):
+        self.path = path
+        self.code = bytearray()
+        self.scripts = []
+        self.strings = []
+        self.labels = {}
+        self.fixups = []
+        self.consts = dict(BUILTINS)
+
+    def error(self, line_no, message):
+        sys.exit("%s:%d: %s" % (self.path, line_no, message))
+
+    def value(self, token, line_no):
+        if token in self.consts:
+            return self.consts[token]
+        try:
+            return int(token, 0)
+        except ValueError:
+            self.error(line_no, "unknown name '%s'" % token)
+
+    def push(self, value):
+        if -128 <= value <= 127:
+            self.code += bytes([OPS["push8"], value & 0xFF])
+        else:
+            self.code += bytes([OPS["push16"]]) + struct.pack("<h", value)
+
+    def jump(self, op, label, line_no):
+        self.code.append(OPS[op])
+        self.fixups.append((len(self.code), label, line_no))
+        self.code += b"\0\0"
+
+    def string(self, text):
+        text = text.replace("\\n", "\n")
+        if text not in self.strings:
+            self.strings.append(text)
+        return self.strings.index(text)
+
+    def compile_line(self, tokens, line_no):
+        op = tokens[0]
+        args = tokens[1:]
+        if op.endswith(":") and not args:
+            self.labels[op[:-1]] = len(self.code)
+        elif op == "const":
+            self.consts[args[0]] = self.value(args[1], line_no)
+        elif op == "script":
+            self.scripts.append(len(self.code))
+        elif op == "end":
+            self.code.append(OPS["end"])
+        elif op == "jump":
+            self.jump("jump", args[0], line_no)
+        elif op in ("if_flag", "unless_flag"):
+            self.push(self.value(args[0], line_no))
+            self.code.append(OPS["get_flag"])
+            if op == "unless_flag":
+                self.jump("jump_if_zero", args[1], line_no)
+            else:
+                # Skip the jump when the flag is clear
+                self.code += bytes([OPS["jump_if_zero"]]) + struct.pack("<H", len(self.code) + 6)
+                self.jump("jump", args[1], line_no)
+        elif op in SIMPLE:
+            if len(args) != SIMPLE[op]:
+                self.error(line_no, "%s takes %d arguments" % (op, SIMPLE[op]))
+            for arg in args:
+                self.push(self.string(arg) if op == "dialog" else self.value(arg, line_no))
+            self.code.append(OPS[op])
+        else:
+            self.error(line_no, "unknown instruction '%s'" % op)
+
+    def compile(self):
+        with open(self.path) as f:
+            for line_no, line in enumerate(f, 1):
+                tokens = shlex.split(line, comments=True)
+                if tokens:
+                    self.compile_line(tokens, line_no)
+
+        for offset, label, line_no in self.fixups:
+            if label not in self.labels:
+                self.error(line_no, "unknown label '%s'" % label)
+            struct.pack_into("<H", self.code, offset, self.labels[label])
+
+        string_data = bytearray()
+        string_offsets = []
+        for text in self.strings:
+            string_offsets.append(len(string_data))
+            string_data += text.encode("ascii") + b"\0"
+
+        header = b"FMS1" + struct.pack("<BBH", len(self.scripts), len(self.strings), len(self.code))
+        tables = b"".join(struct.pack("<H", o) for o in self.scripts + string_offsets)
+        return header + tables + bytes(self.code) + bytes(string_data)
+
+
+def main():
+    out_dir = os.path.join(ROOT, "assets", "scripts")
+    os.makedirs(out_dir, exist_ok=True)
+    for source in sorted(glob.glob(os.path.join(ROOT, "scripts", "*.fms"))):
+        data = Compiler(source).compile()
+        name = os.path.splitext(os.path.basename(source))[0] + ".fsb"
+        with open(os.path.join(out_dir, name), "wb") as f:
+            f.write(data)
+        print("%s: %d bytes" % (name, len(data)))
+
+
+if __name__ == "__main__":
+    main()